@@ -13,6 +13,7 @@ http://www.boost.org/LICENSE_1_0.txt
 #if !defined(BOOST_ALGORITHM_SEQUENCE_EXAMPLE_EDIT_DISTANCE_COMMON_HPP)
 #define BOOST_ALGORITHM_SEQUENCE_EXAMPLE_EDIT_DISTANCE_COMMON_HPP
 
+#include <iostream>
 #include <sstream>
 #include <list>
 #include <vector>
@@ -0,0 +1,222 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_BK_TREE_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_BK_TREE_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+// A set of sequences, indexed for lookups of those near a query under edit distance, as a metric tree:
+//     Some Approaches to Best-Match File Searching
+//     by W. A. Burkhard and R. M. Keller, Communications of the ACM 16(4), 1973
+// Each sequence below a node is filed under its distance from that node, and by the triangle
+// inequality a query (q) at distance (d) from a node can only be within (k) of the sequences filed
+// under distances [d-k, d+k].  A node is compared with a query under a max cost just large enough to
+// tell which of its children to visit, so the comparisons with far away nodes stop early.
+// The distance must be a metric: unit costs are, with or without substitution; a cost function has
+// to be symmetric and satisfy the triangle inequality.  Sequences a distance of zero apart are
+// counted as equal, and the tree holds one of them.
+// Lookups may run concurrently, each in the default workspace of its thread.
+template <typename Sequence, typename Cost = unit_cost, typename AllowSub = boost::false_type, typename Equal = default_equal>
+class bk_tree {
+public:
+    typedef Sequence value_type;
+    typedef typename detail::cost_type<Cost, typename range_value<Sequence>::type>::type cost_type;
+    typedef typename std::vector<Sequence>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef typename std::vector<Sequence>::size_type size_type;
+    // a sequence found by a lookup, and its distance from the query
+    typedef std::pair<const_iterator, cost_type> match_type;
+
+    explicit bk_tree(const Cost& cost_ = Cost(), const AllowSub& allow_sub_ = AllowSub(), const Equal& equal_ = Equal())
+        : cost(cost_), allow_sub(allow_sub_), equal(equal_) {}
+
+    // sequences in the order they were inserted
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    size_type size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    void clear() {
+        values.clear();
+        nodes.clear();
+    }
+
+    // Inserts a sequence, unless one at distance zero from it is held already.  Returns the sequence
+    // held, and whether it was inserted
+    std::pair<const_iterator, bool> insert(const Sequence& seq) {
+        if (nodes.empty()) return append(seq, 0);
+        lookup<Sequence> q(seq, *this);
+        std::size_t x = 0;
+        while (true) {
+            const cost_type d = q(values[x], detail::none());
+            if (d == cost_type(0)) return std::make_pair(values.begin() + x, false);
+            std::size_t c = nodes[x].child;
+            while (c != npos  &&  nodes[c].dist != d) c = nodes[c].sibling;
+            if (c == npos) {
+                std::pair<const_iterator, bool> r = append(seq, d);
+                nodes.back().sibling = nodes[x].child;
+                nodes[x].child = nodes.size()-1;
+                nodes[x].reach = std::max(nodes[x].reach, d);
+                return r;
+            }
+            x = c;
+        }
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (;  first != last;  ++first) insert(*first);
+    }
+
+    // Writes every sequence within distance (k) of a query to an output iterator, as a match_type,
+    // in no particular order.  Returns the output iterator past the last match
+    template <typename Query, typename OutputIterator>
+    OutputIterator find_within(const Query& query, const cost_type& k, OutputIterator out) const {
+        if (nodes.empty()) return out;
+        lookup<Query> q(query, *this);
+        std::vector<std::size_t> stack(1, 0);
+        while (!stack.empty()) {
+            const std::size_t x = stack.back();
+            stack.pop_back();
+            // past (reach + k) neither the node nor any of its children can hold a match
+            const cost_type d = q(values[x], detail::max_cost_bound<cost_type>(nodes[x].reach + k));
+            if (d <= k) {
+                *out = match_type(values.begin() + x, d);
+                ++out;
+            }
+            if (d > nodes[x].reach + k) continue;
+            for (std::size_t c = nodes[x].child;  c != npos;  c = nodes[c].sibling) {
+                if (within(nodes[c].dist, d, k)) stack.push_back(c);
+            }
+        }
+        return out;
+    }
+
+    // Writes the (n) sequences nearest to a query to an output iterator, as match_type, nearest first.
+    // Of sequences equally far away, which are written is unspecified.  Returns the output iterator
+    // past the last match
+    template <typename Query, typename OutputIterator>
+    OutputIterator k_nearest(const Query& query, const size_type& n, OutputIterator out) const {
+        if (nodes.empty()  ||  n == 0) return out;
+        lookup<Query> q(query, *this);
+        // nearest so far, as a max-heap on distance, and nodes to visit as a min-heap on the least
+        // distance the triangle inequality leaves for them
+        std::vector<match_type> best;
+        std::vector<std::pair<cost_type, std::size_t> > visit(1, std::make_pair(cost_type(0), std::size_t(0)));
+        while (!visit.empty()) {
+            std::pop_heap(visit.begin(), visit.end(), std::greater<std::pair<cost_type, std::size_t> >());
+            const std::pair<cost_type, std::size_t> v = visit.back();
+            visit.pop_back();
+            const bool full = best.size() >= n;
+            if (full  &&  v.first > best.front().second) break;
+
+            const std::size_t x = v.second;
+            cost_type d;
+            if (full) {
+                const cost_type r = best.front().second;
+                d = q(values[x], detail::max_cost_bound<cost_type>(nodes[x].reach + r));
+                if (d > nodes[x].reach + r) continue;
+            } else {
+                d = q(values[x], detail::none());
+            }
+            if (!full  ||  d < best.front().second) {
+                if (full) {
+                    std::pop_heap(best.begin(), best.end(), match_farther());
+                    best.pop_back();
+                }
+                best.push_back(match_type(values.begin() + x, d));
+                std::push_heap(best.begin(), best.end(), match_farther());
+            }
+
+            for (std::size_t c = nodes[x].child;  c != npos;  c = nodes[c].sibling) {
+                const cost_type lb = (nodes[c].dist < d) ? d - nodes[c].dist : nodes[c].dist - d;
+                if (best.size() >= n  &&  lb > best.front().second) continue;
+                visit.push_back(std::make_pair(lb, c));
+                std::push_heap(visit.begin(), visit.end(), std::greater<std::pair<cost_type, std::size_t> >());
+            }
+        }
+        std::sort_heap(best.begin(), best.end(), match_farther());
+        return std::copy(best.begin(), best.end(), out);
+    }
+
+private:
+    static const std::size_t npos = std::size_t(-1);
+
+    // a node holds the sequence of the same index, its distance from its parent, the greatest such
+    // distance among its children, and the links from its first child to the next
+    struct node {
+        cost_type dist;
+        cost_type reach;
+        std::size_t child;
+        std::size_t sibling;
+        node(const cost_type& dist_) : dist(dist_), reach(0), child(npos), sibling(npos) {}
+    };
+
+    struct match_farther {
+        inline bool operator()(const match_type& a, const match_type& b) const { return a.second < b.second; }
+    };
+
+    std::pair<const_iterator, bool> append(const Sequence& seq, const cost_type& d) {
+        values.push_back(seq);
+        nodes.push_back(node(d));
+        return std::make_pair(values.end() - 1, true);
+    }
+
+    // A query compared with node after node: what depends on the query alone is prepared once (see
+    // edit_distance_batch), and the comparisons run in the default workspace of the thread
+    template <typename Query>
+    class lookup : private boost::noncopyable {
+    public:
+        typedef typename range_iterator<Query const>::type itr_t;
+        typedef boost::iterator_range<itr_t> range_t;
+
+        lookup(const Query& query, const bk_tree& tree)
+            : range(as_literal(query)), q(range, tree.cost, tree.equal, tree.allow_sub) {}
+
+        template <typename MaxCost>
+        inline cost_type operator()(const Sequence& seq, const MaxCost& max_cost) { return q(as_literal(seq), max_cost, workspace.get()); }
+
+    private:
+        const range_t range;
+        detail::batch_query<range_t, Cost, Equal, AllowSub> q;
+        detail::default_workspace workspace;
+    };
+
+    static inline bool within(const cost_type& dist, const cost_type& d, const cost_type& k) {
+        return (dist < d) ? (d - dist <= k) : (dist - d <= k);
+    }
+
+    Cost cost;
+    AllowSub allow_sub;
+    Equal equal;
+    std::vector<Sequence> values;
+    std::vector<node> nodes;
+};
+
+template <typename Sequence, typename Cost, typename AllowSub, typename Equal>
+const std::size_t bk_tree<Sequence, Cost, AllowSub, Equal>::npos;
+
+}}} // boost::algorithm::sequence
+
+#endif
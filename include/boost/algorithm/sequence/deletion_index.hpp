@@ -0,0 +1,199 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DELETION_INDEX_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DELETION_INDEX_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_postings.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+// the keys left by up to (d) more deletions from (seq), at positions from (from) on
+template <typename V>
+void deletion_keys(std::vector<V>& seq, const std::size_t& from, const std::size_t& d, std::vector<std::size_t>& keys) {
+    keys.push_back(boost::hash_range(seq.begin(), seq.end()));
+    if (d == 0) return;
+    for (std::size_t p = from;  p < seq.size();  ++p) {
+        // deleting any one of a run of equal elements leaves the same sequence
+        if (p > from  &&  seq[p] == seq[p-1]) continue;
+        const V v = seq[p];
+        seq.erase(seq.begin() + p);
+        deletion_keys(seq, p, d-1, keys);
+        seq.insert(seq.begin() + p, v);
+    }
+}
+
+// The keys of the sequences left by deleting up to (d) elements of the first (prefix) elements of a
+// sequence, itself included, in increasing order.  The keys are hashes, and sequences whose keys
+// collide are taken as one, which only ever makes more candidates
+template <typename Range>
+void deletion_keys(Range const& seq, const std::size_t& prefix, const std::size_t& d, std::vector<std::size_t>& keys) {
+    typedef typename range_iterator<Range const>::type itr_t;
+    itr_t e = boost::begin(seq);
+    for (std::size_t j = 0;  j < prefix  &&  e != boost::end(seq);  ++j) ++e;
+    std::vector<typename boost::remove_cv<typename range_value<Range>::type>::type> s(boost::begin(seq), e);
+    keys.clear();
+    deletion_keys(s, 0, d, keys);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+} // detail
+
+// An index of records (sequences) for lookups of those within a small unit cost edit distance of a
+// query, by symmetric deletion: each record is filed under every sequence left by deleting up to
+// (depth) of its first (prefix) elements.  Two sequences within (k) of each other, with or without
+// substitution, are each left with a common subsequence by at most (k) deletions, and so are their
+// prefixes of any one length.  A lookup needs only the records filed under the deletions of the
+// prefix of the query, and verifies them by an edit distance under a max cost of (k):
+//     SymSpell, by Wolf Garbe, https://github.com/wolfgarbe/SymSpell
+// Lookups take time independent of the number of records, at the cost of memory for up to
+// (prefix choose depth) entries per record; a longer prefix makes more entries, and fewer
+// candidates to verify.  A lookup past the depth indexed falls back to a scan.  Elements are
+// compared with operator== and hashed with boost::hash.  Lookups may run concurrently, each in the
+// default workspace of its thread; an insertion invalidates the iterators to records, as for a
+// std::vector.
+template <typename Sequence, typename AllowSub = boost::false_type>
+class deletion_index {
+public:
+    typedef Sequence value_type;
+    typedef unit_cost::cost_type cost_type;
+    typedef typename std::vector<Sequence>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef typename std::vector<Sequence>::size_type size_type;
+    // a record found by a lookup, and its distance from the query
+    typedef std::pair<const_iterator, cost_type> match_type;
+
+    explicit deletion_index(const cost_type& depth_ = 2, const std::size_t& prefix_ = 7, const AllowSub& allow_sub_ = AllowSub())
+        : d(depth_), prefix(prefix_), allow_sub(allow_sub_) {}
+
+    // records in the order they were inserted
+    const_iterator begin() const { return records.begin(); }
+    const_iterator end() const { return records.end(); }
+    size_type size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+
+    // the most deletions indexed, and so the largest distance looked up without a scan
+    cost_type depth() const { return d; }
+    std::size_t prefix_length() const { return prefix; }
+
+    // the number of distinct deletion keys, and the bytes their posting lists take
+    std::size_t keys() const { return postings.size(); }
+    std::size_t posting_bytes() const {
+        std::size_t b = 0;
+        for (typename postings_t::const_iterator j = postings.begin();  j != postings.end();  ++j) b += j->second.byte_size();
+        return b;
+    }
+
+    void clear() {
+        records.clear();
+        lengths.clear();
+        postings.clear();
+    }
+
+    const_iterator insert(const Sequence& seq) {
+        const boost::uint32_t r = boost::uint32_t(records.size());
+        std::vector<std::size_t> keys;
+        detail::deletion_keys(as_literal(seq), prefix, d, keys);
+        for (std::size_t j = 0;  j < keys.size();  ++j) postings[keys[j]].push_back(r);
+        records.push_back(seq);
+        lengths.push_back(std::size_t(boost::distance(as_literal(seq))));
+        return records.end() - 1;
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (;  first != last;  ++first) insert(*first);
+    }
+
+    // Writes every record within distance (k) of a query to an output iterator, as a match_type, in
+    // the order they were inserted.  Returns the output iterator past the last match
+    template <typename Query, typename OutputIterator>
+    OutputIterator find_within(const Query& query, const cost_type& k, OutputIterator out) const {
+        typedef typename range_iterator<Query const>::type itr_t;
+        typedef boost::iterator_range<itr_t> range_t;
+        const range_t qr(as_literal(query));
+        const std::size_t qlen = std::size_t(boost::distance(qr));
+
+        detail::default_workspace workspace;
+        detail::batch_query<range_t, unit_cost, detail::default_equal, AllowSub> verify(qr, unit_cost(), detail::default_equal(), allow_sub);
+        const detail::max_cost_bound<cost_type> max_cost(k);
+
+        if (k > d) {
+            for (std::size_t r = 0;  r < records.size();  ++r) {
+                if (!length_within(lengths[r], qlen, k)) continue;
+                const cost_type dist = verify(as_literal(records[r]), max_cost, workspace.get());
+                if (dist <= k) {
+                    *out = match_type(records.begin() + r, dist);
+                    ++out;
+                }
+            }
+            return out;
+        }
+
+        std::vector<std::size_t> keys;
+        detail::deletion_keys(qr, prefix, k, keys);
+        detail::workspace_lease<detail::posting_counts> c(workspace.get());
+        c->count.resize(records.size(), 0);
+        c->touched.clear();
+        for (std::size_t j = 0;  j < keys.size();  ++j) {
+            const typename postings_t::const_iterator p = postings.find(keys[j]);
+            if (p != postings.end()) p->second.for_each(*c);
+        }
+
+        std::sort(c->touched.begin(), c->touched.end());
+        for (std::size_t j = 0;  j < c->touched.size();  ++j) {
+            const boost::uint32_t r = c->touched[j];
+            c->count[r] = 0;
+            if (!length_within(lengths[r], qlen, k)) continue;
+            const cost_type dist = verify(as_literal(records[r]), max_cost, workspace.get());
+            if (dist <= k) {
+                *out = match_type(records.begin() + r, dist);
+                ++out;
+            }
+        }
+        return out;
+    }
+
+private:
+    typedef boost::unordered_map<std::size_t, detail::posting_list> postings_t;
+
+    static inline bool length_within(const std::size_t& a, const std::size_t& b, const std::size_t& k) {
+        return ((a < b) ? (b - a) : (a - b)) <= k;
+    }
+
+    cost_type d;
+    std::size_t prefix;
+    AllowSub allow_sub;
+    std::vector<Sequence> records;
+    std::vector<std::size_t> lengths;
+    postings_t postings;
+};
+
+}}} // boost::algorithm::sequence
+
+#endif
@@ -14,16 +14,22 @@ http://www.boost.org/LICENSE_1_0.txt
 #if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_HPP)
 #define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_HPP
 
-// this requires me to link against boost system lib, which disappoints me,
-// since it prevents my algorithms from being pure-template.
-// maybe figure out how to use a pure-template pool allocator later
-#include <boost/pool/object_pool.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <boost/heap/skew_heap.hpp>
 
 #include <boost/range/metafunctions.hpp>
 
 #include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_bitparallel.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_snake.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_diagonal.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_lcp.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_materialize.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_filter.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_workspace.hpp>
 #include <boost/algorithm/sequence/detail/edit_distance_script.hpp>
 
 namespace boost {
@@ -38,15 +44,13 @@ using boost::make_tuple;
 using boost::enable_if;
 using boost::is_same;
 using boost::mpl::and_;
+using boost::mpl::or_;
 using std::iterator_traits;
 using std::random_access_iterator_tag;
 
-template <typename ForwardRange1, typename ForwardRange2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
-struct edit_cost_struct<ForwardRange1, ForwardRange2, Output, Cost, Equal, AllowSub, MaxCost,
-                        typename enable_if<and_<is_same<Output, none>,
-                                                not_<and_<range_category<ForwardRange1, ForwardRange2, random_access_iterator_tag>,
-                                                          is_same<Cost, unit_cost>,
-                                                          is_same<AllowSub, boost::false_type> > > > >::type> {
+// Default is generic edit distance algorithm based on a Dijkstra Single Source Shortest Path approach
+template <typename ForwardRange1, typename ForwardRange2, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+struct edit_cost_sssp {
 typedef typename cost_type<Cost, typename boost::range_value<ForwardRange1>::type>::type cost_t;
 typedef typename range_iterator<ForwardRange1 const>::type itr1_t;
 typedef typename range_iterator<ForwardRange2 const>::type itr2_t;
@@ -56,6 +60,7 @@ typedef typename head_t::pos2_type pos2_t;
 
 cost_t max_cost_fallback(max_cost_checker<MaxCost, cost_t, head_t>& max_cost_check, bool max_cost_exception, const itr1_t end1, const itr2_t end2, const Cost& cost, const Equal& equal, sub_checker<AllowSub, Cost, cost_t, int> const& allow_sub) const {
     if (max_cost_exception) throw max_edit_cost_exception();
+    if (max_cost_check.bounded()) return max_cost_check.past();
 
     head_t* h;
     max_cost_check.get(h);
@@ -86,38 +91,43 @@ cost_t max_cost_fallback(max_cost_checker<MaxCost, cost_t, head_t>& max_cost_che
     return C;
 }
 
-// Default is generic edit distance algorithm based on a Dijkstra Single Source Shortest Path approach
 typename cost_type<Cost, typename boost::range_value<ForwardRange1>::type>::type
-operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, none&, const Cost& cost, const Equal& equal, const AllowSub& allowsub, const MaxCost& max_cost, const bool max_cost_exception) const {
+operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, none&, const Cost& cost, const Equal& equal, const AllowSub& allowsub, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
 
     head_t* const hnull = static_cast<head_t*>(NULL);
 
     const itr1_t end1 = boost::end(seq1);
     const itr2_t end2 = boost::end(seq2);
-    pos1_t beg1;  beg1.beg(boost::begin(seq1));
-    pos2_t beg2;  beg2.beg(boost::begin(seq2));
 
-    // pool allocator for path nodes
-    boost::object_pool<head_t> pool;
+    // the search begins past any equal prefix
+    itr1_t pfx1 = boost::begin(seq1);
+    itr2_t pfx2 = boost::begin(seq2);
+    equal_prefix(pfx1, end1, pfx2, end2, equal);
+
+    pos1_t beg1;  beg1.beg(pfx1);
+    pos2_t beg2;  beg2.beg(pfx2);
 
-    // priority queue for path nodes
-    boost::heap::skew_heap<head_t*, boost::heap::compare<heap_lessthan<pos1_t, pos2_t> > > heap(heap_lessthan<pos1_t, pos2_t>(beg1, beg2));
+    // path nodes, the visited nodes of the edit graph, and a priority queue of path nodes,
+    // kept by the workspace between calls
+    workspace_lease<sssp_workspace<head_t, visited_hash<pos1_t,pos2_t>, visited_equal> > ws(workspace);
+    ws->reset(visited_hash<pos1_t,pos2_t>(beg1,beg2));
+    node_arena<head_t>& pool = ws->pool;
+    visited_table<head_t, visited_hash<pos1_t,pos2_t>, visited_equal>& visited = ws->visited;
+    std::vector<head_t*>& heap = ws->heap;
+    const heap_lessthan<pos1_t, pos2_t> heap_order(beg1, beg2);
 
     sub_checker<AllowSub, Cost, cost_t, int> allow_sub(allowsub);
 
     max_cost_checker<MaxCost, cost_t, head_t> max_cost_check(max_cost, beg1, beg2);
 
-    // keep track of nodes in the edit graph that have been visited
-    typedef boost::unordered_set<head_t*, visited_hash<pos1_t,pos2_t>, visited_equal> visited_t;
-    visited_t visited(31, visited_hash<pos1_t,pos2_t>(beg1,beg2));
-
     // kick off graph path frontier with initial node:
-    heap.push(construct(pool, visited, beg1, beg2, cost_t(0)));
+    heap.push_back(construct(pool, visited, beg1, beg2, cost_t(0)));
 
     // update frontier from least-cost node at each iteration, until we hit sequence end
     while (true) {
-        head_t* h = heap.top();
-        heap.pop();
+        std::pop_heap(heap.begin(), heap.end(), heap_order);
+        head_t* h = heap.back();
+        heap.pop_back();
 
         if (max_cost_check(h->cost)) {
             return max_cost_fallback(max_cost_check, max_cost_exception, end1, end2, cost, equal, allow_sub);
@@ -130,30 +140,31 @@ operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, none&, const Co
             // sequence 1 is at end, so only consider insertion from seq2
             pos2_t p2 = h->pos2;
             head_t* t = construct(pool, visited, h->pos1, ++p2, h->cost + cost.insertion(*(h->pos2)));
-            if (t != hnull) heap.push(t);
+            if (t != hnull) heap_push(heap, t, heap_order);
         } else if (h->pos2 == end2) {
             // sequence 2 is at end, so only consider deletion from seq1
             pos1_t p1 = h->pos1;
             head_t* t = construct(pool, visited, ++p1, h->pos2, h->cost + cost.deletion(*(h->pos1)));
-            if (t != hnull) heap.push(t);
+            if (t != hnull) heap_push(heap, t, heap_order);
         } else {
             // interior of both sequences: consider insertion deletion and sub/eql:
             pos1_t p1 = h->pos1;  ++p1;
             pos1_t p1p = h->pos1;
             pos2_t p2 = h->pos2;  ++p2;
             pos2_t p2p = h->pos2;
+            snake<itr1_t, itr2_t, Equal>::skip(p1p, p1, p2p, p2, end1, end2, equal);
             while (true) {
                 const bool eq = equal(*p1p, *p2p);
                 if (!eq  ||  p1 == end1  ||  p2 == end2) {
                     head_t* t;
                     if (allow_sub() || eq) {
                         t = construct(pool, visited, p1, p2, h->cost + ((eq) ? 0 : allow_sub.substitution(cost, *p1p, *p2p)));
-                        if (t != hnull) heap.push(t);
+                        if (t != hnull) heap_push(heap, t, heap_order);
                     }
                     t = construct(pool, visited, p1p, p2, h->cost + cost.insertion(*p2p));
-                    if (t != hnull) heap.push(t);
+                    if (t != hnull) heap_push(heap, t, heap_order);
                     t = construct(pool, visited, p1, p2p, h->cost + cost.deletion(*p1p));
-                    if (t != hnull) heap.push(t);
+                    if (t != hnull) heap_push(heap, t, heap_order);
                     break;
                 }
                 ++p1;  ++p2;  ++p1p;  ++p2p;
@@ -166,6 +177,17 @@ operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, none&, const Co
     return 0;
 }
 
+}; // edit_cost_sssp
+
+
+template <typename ForwardRange1, typename ForwardRange2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+struct edit_cost_struct<ForwardRange1, ForwardRange2, Output, Cost, Equal, AllowSub, MaxCost,
+                        typename enable_if<and_<is_same<Output, none>,
+                                                not_<and_<range_category<ForwardRange1, ForwardRange2, random_access_iterator_tag>,
+                                                          is_same<Cost, unit_cost>,
+                                                          or_<is_same<AllowSub, boost::false_type>,
+                                                              is_same<AllowSub, boost::true_type> > > > > >::type>
+    : public edit_cost_sssp<ForwardRange1, ForwardRange2, Cost, Equal, AllowSub, MaxCost> {
 }; // edit_cost_struct
 
 
@@ -180,7 +202,6 @@ typedef typename range_iterator<Range2 const>::type itr2_t;
 typedef std::vector<int>::difference_type diff_type;
 typedef std::vector<int>::size_type size_type;
 
-typedef typename std::vector<diff_type>::iterator itrv_t;
 typedef max_cost_checker_myers<MaxCost, diff_type, diff_type> max_cost_type;
 
 std::string dump(const itr1_t& S1, const size_type& len1) const {
@@ -189,28 +210,12 @@ std::string dump(const itr1_t& S1, const size_type& len1) const {
     return r;
 }
 
-template <typename Vec, typename Itr> 
-inline void expand(Vec& V_data, Itr& Vf, Itr& Vr, size_type& R, const diff_type& D, const diff_type& delta) const {
-    size_type Rp = R + (R>>1);
-    V_data.resize(2 + 4*Rp);
-    Vf = V_data.begin() + R;
-    Vr = V_data.begin() + (3*R+1) - delta;
-
-    Itr Vp = V_data.begin() + (3*Rp+1) - delta;
-    for (diff_type j=D+delta;  j >= -D+delta;  --j) Vp[j] = Vr[j];
-    Vr = Vp;
-
-    Vp = V_data.begin() + Rp;
-    for (diff_type j=D;  j >= -D;  --j) Vp[j] = Vf[j];
-    Vf = Vp;
-
-    R = Rp;
-}
-
+template <typename T>
 diff_type max_cost_fallback(max_cost_type& max_cost_check, const bool max_cost_exception, const Equal& equal,
                             const itr1_t& S1, const size_type& L1, const itr2_t& S2, const size_type& L2,
-                            const itrv_t& Vf, const itrv_t& Vr, const diff_type& delta, const diff_type& D) const {
+                            const T* Vf, const T* Vr, const diff_type& delta, const diff_type& D) const {
     if (max_cost_exception) throw max_edit_cost_exception();
+    if (max_cost_check.bounded()) return max_cost_check.past();
 
     for (diff_type k = -D;  k <= D;  k += 2) {
         max_cost_check.update(k, Vf, Vr, delta, L1, L2, D);
@@ -276,6 +281,13 @@ diff_type max_cost_fallback(max_cost_type& max_cost_check, const bool max_cost_e
     return C;
 }
 
+template <typename ItrP, typename ItrT, typename EqualP>
+diff_type lcs_distance(const ItrP& P, const diff_type& m, const ItrT& T, const diff_type& n, const EqualP& equal) const {
+    const block_match_mask<ItrP, ItrT, EqualP> peq(P, m, equal);
+    std::vector<bitvec_t> V;
+    return m + n - 2*bitparallel_lcs(m, T, n, peq, V);
+}
+
 // If we are using unit cost for ins/del, with no substitution,
 // and if our sequences support random-access,
 // *then* we can invoke the efficient and elegant Myers algorithm:
@@ -283,18 +295,15 @@ diff_type max_cost_fallback(max_cost_type& max_cost_check, const bool max_cost_e
 //     by Eugene W. Myers
 //     Dept of Computer Science, University of Arizona
 typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
-operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, const Equal& equal, const boost::false_type&, const MaxCost& max_cost, const bool max_cost_exception) const {
+operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, const Equal& equal, const boost::false_type&, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
     itr1_t seq1 = boost::begin(seq1_);
     itr2_t seq2 = boost::begin(seq2_);
     size_type len1 = distance(seq1_);
     size_type len2 = distance(seq2_);
 
     // identify any equal suffix and/or prefix
-    diff_type eqb = 0;
-    for (;  eqb < std::min(len1, len2);  ++eqb) if (!equal(seq1[eqb],seq2[eqb])) break;
-    diff_type eqe = len1-1;
-    for (diff_type j2 = len2-1;  eqe > eqb && j2 > eqb;  --eqe,--j2) if (!equal(seq1[eqe],seq2[j2])) break;
-    eqe = len1-1-eqe;
+    diff_type eqb, eqe;
+    equal_affixes(seq1, len1, seq2, len2, equal, eqb, eqe);
 
     // sub-strings with equal suffix and/or prefix stripped
     const itr1_t S1 = seq1 + eqb;
@@ -306,16 +315,31 @@ operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, co
     if (L1 <= 0) return L2;
     if (L2 <= 0) return L1;
 
+    // the diagonals are kept in the narrowest type that holds their positions
+    if (myers_fits<boost::int16_t>(L1, L2)) return myers_distance<boost::int16_t>(S1, L1, S2, L2, equal, max_cost, max_cost_exception, workspace);
+    if (myers_fits<boost::int32_t>(L1, L2)) return myers_distance<boost::int32_t>(S1, L1, S2, L2, equal, max_cost, max_cost_exception, workspace);
+    return myers_distance<diff_type>(S1, L1, S2, L2, equal, max_cost, max_cost_exception, workspace);
+}
+
+template <typename T>
+diff_type myers_distance(const itr1_t& S1, const diff_type& L1, const itr2_t& S2, const diff_type& L2, const Equal& equal, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
     const diff_type delta = L1-L2;
     const bool delta_even = delta%2 == 0;
 
-    size_type R = 10;
-    std::vector<diff_type> V_data(2*(1 + 2*R));
-    itrv_t Vf = V_data.begin()+R;
-    itrv_t Vr = V_data.begin()+(3*R+1)-delta;
+    workspace_lease<diagonal_workspace<edit_cost_struct, T> > ws(workspace);
+    myers_diagonals<T> V(ws->V);
+    V.start(delta);
+    T*& Vf = V.Vf;
+    T*& Vr = V.Vr;
 
     max_cost_type max_cost_check(max_cost);
 
+    // Myers does O(D^2) diagonal steps (plus snakes) to reach round D, while the bit-parallel LCS
+    // has a fixed O(n*m/w) cost, plus setting up its match table.  The rounds completed so far are a
+    // running estimate of divergence: once they pass the crossover, the sequences are dissimilar
+    // enough to switch algorithms
+    const diff_type crossover = 256 + std::max(L1, L2) * ((std::min(L1, L2) + bitvec_bits-1) / bitvec_bits);
+
     diff_type D = 0;
     Vf[1] = 0;
     Vr[-1+delta] = L1;
@@ -329,7 +353,7 @@ operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, co
                 diff_type r2 = Vr[k]-k;
                 if ((j1-j2) == (r1-r2)  &&  j1 >= r1) return 2*D-1;
             }
-            while (j1 < L1  &&  j2 < L2  &&  equal(S1[j1], S2[j2])) { ++j1;  ++j2; }
+            { const diff_type s = snake_forward(S1+j1, S2+j2, std::min(L1-j1, L2-j2), equal);  j1 += s;  j2 += s; }
             Vf[k] = j1;
         }
 
@@ -342,7 +366,7 @@ operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, co
                 diff_type f2 = Vf[k]-k;
                 if ((j1-j2) == (f1-f2)  &&  f1 >= j1) return 2*D;
             }
-            while (j1 > 0  &&  j2 > 0  &&  equal(S1[j1-1], S2[j2-1])) { --j1;  --j2; }
+            { const diff_type s = snake_reverse(S1+j1, S2+j2, std::min(j1, j2), equal);  j1 -= s;  j2 -= s; }
             Vr[k] = j1;
         }
 
@@ -352,8 +376,15 @@ operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, co
                                      Vf, Vr, delta, D);
         }
 
+        if (D*D > crossover) {
+            const diff_type C = (L1 <= L2) ? lcs_distance(S1, L1, S2, L2, equal)
+                                           : lcs_distance(S2, L2, S1, L1, swap_equal<Equal>(equal));
+            if (max_cost_exception  &&  max_cost_check(C)) throw max_edit_cost_exception();
+            return C;
+        }
+
         // expand the working vector as needed
-        if (D >= R) expand(V_data, Vf, Vr, R, D, delta);
+        if (D >= V.R) V.expand(D, delta);
         ++D;
     }
 
@@ -365,14 +396,121 @@ operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, co
 }; // edit_cost_struct
 
 
-template <typename Range1, typename Range2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+template <typename Range1, typename Range2, typename Output, typename Equal, typename MaxCost>
+struct edit_cost_struct<Range1, Range2, Output, unit_cost, Equal, boost::true_type, MaxCost,
+                        typename enable_if<and_<is_same<Output, none>,
+                                                range_category<Range1, Range2, random_access_iterator_tag> > >::type> {
+
+typedef typename range_iterator<Range1 const>::type itr1_t;
+typedef typename range_iterator<Range2 const>::type itr2_t;
+
+typedef std::vector<int>::difference_type diff_type;
+typedef std::vector<int>::size_type size_type;
+
+typedef max_cost_checker_myers<MaxCost, diff_type, diff_type> max_cost_type;
+
+template <typename ItrP, typename ItrT, typename EqualP>
+diff_type blocked_distance(const ItrP& P, const diff_type& m, const ItrT& T, const diff_type& n, const EqualP& equal, const max_cost_type& max_cost_check) const {
+    const block_match_mask<ItrP, ItrT, EqualP> peq(P, m, equal);
+    bitvec_blocks blocks;
+    return bitparallel_blocked_distance(m, T, n, peq, blocks, max_cost_check);
+}
+
+// If we are using unit cost with substitution, and our sequences support random-access,
+// then we can compute the distance column-by-column in bit-parallel.  When the shorter
+// sequence fits in a machine word this needs no allocation (see bitparallel_distance).
+// Otherwise furthest-reaching diagonals are tried first, which take O(ND) time on similar
+// sequences (see diagonal_distance), and past their crossover the bit-parallel computation
+// works on blocks of words over a band (see bitparallel_banded_distance)
+typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
+operator()(Range1 const& seq1_, Range2 const& seq2_, none&, const unit_cost&, const Equal& equal, const boost::true_type&, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
+    itr1_t seq1 = boost::begin(seq1_);
+    itr2_t seq2 = boost::begin(seq2_);
+    size_type len1 = distance(seq1_);
+    size_type len2 = distance(seq2_);
+
+    // identify any equal suffix and/or prefix
+    diff_type eqb, eqe;
+    equal_affixes(seq1, len1, seq2, len2, equal, eqb, eqe);
+
+    // sub-strings with equal suffix and/or prefix stripped
+    const itr1_t S1 = seq1 + eqb;
+    const diff_type L1 = len1-(eqb+eqe);
+    const itr2_t S2 = seq2 + eqb;
+    const diff_type L2 = len2-(eqb+eqe);
+
+    max_cost_type max_cost_check(max_cost);
+
+    diff_type D;
+    if (L1 <= 0) {
+        D = L2;
+    } else if (L2 <= 0) {
+        D = L1;
+    } else if (L1 <= L2  &&  L1 <= bitvec_bits) {
+        D = bitparallel_distance(S1, L1, S2, L2, equal, max_cost_check);
+    } else if (L2 <= bitvec_bits) {
+        D = bitparallel_distance(S2, L2, S1, L1, swap_equal<Equal>(equal), max_cost_check);
+    } else {
+        workspace_lease<diagonal_workspace<edit_cost_struct> > ws(workspace);
+        D = diagonal_distance(S1, L1, S2, L2, equal, max_cost_check, ws->V);
+        if (D < 0) {
+            D = (L1 <= L2) ? blocked_distance(S1, L1, S2, L2, equal, max_cost_check)
+                           : blocked_distance(S2, L2, S1, L1, swap_equal<Equal>(equal), max_cost_check);
+        }
+    }
+
+    if (max_cost_exception  &&  max_cost_check(D)) throw max_edit_cost_exception();
+    return D;
+}
+
+}; // edit_cost_struct
+
+
+template <typename Range1, typename Range2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost, typename Index>
 inline
 typename cost_type<Cost, typename boost::range_value<Range1>::type>::type
-edit_cost_impl(Range1 const& seq1, Range2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception) {
+edit_cost_indexed(Range1 const& seq1, Range2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, edit_distance_workspace& workspace) {
+    // a snake index, if one applies, travels with the element equality
+    typedef snake_index_equal<Range1, Range2, Equal, Index> index_equal;
+    typedef typename index_equal::type equal_t;
+
     // specialize the most appropriate implementation for the given parameters
-    return edit_cost_struct<Range1, Range2, Output, Cost, Equal, AllowSub, MaxCost>()(seq1, seq2, output, cost, equal, allow_sub, max_cost, max_cost_exception);
+    return edit_cost_struct<Range1, Range2, Output, Cost, equal_t, AllowSub, MaxCost>()(seq1, seq2, output, cost, index_equal::make(seq1, seq2, equal, index), allow_sub, max_cost, max_cost_exception, workspace);
 }
 
+// Only the unit cost engines have random access paths to gain from materializing the sequences
+template <typename Range1, typename Range2, typename Output, typename Cost, typename Enable = void>
+struct edit_cost_materialize {
+    template <typename Equal, typename AllowSub, typename MaxCost, typename Index>
+    static inline typename cost_type<Cost, typename boost::range_value<Range1>::type>::type
+    run(Range1 const& seq1, Range2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, edit_distance_workspace& workspace) {
+        return edit_cost_indexed(seq1, seq2, output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace);
+    }
+};
+
+template <typename Range1, typename Range2, typename Output>
+struct edit_cost_materialize<Range1, Range2, Output, unit_cost,
+                             typename enable_if<not_<range_category<Range1, Range2, random_access_iterator_tag> > >::type> {
+    template <typename Equal, typename AllowSub, typename MaxCost, typename Index>
+    static inline typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
+    run(Range1 const& seq1, Range2 const& seq2, Output& output, const unit_cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, edit_distance_workspace& workspace) {
+        if (!combined_length_reaches(seq1, seq2, BOOST_ALGORITHM_SEQUENCE_MATERIALIZE_LENGTH)) {
+            return edit_cost_indexed(seq1, seq2, output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace);
+        }
+        workspace_lease<materialized_buffers<typename materialized<Range1, Output>::buffer_type, typename materialized<Range2, Output>::buffer_type> > ws(workspace);
+        ws->buf1.clear();
+        ws->buf2.clear();
+        return edit_cost_indexed(materialized<Range1, Output>::make(seq1, ws->buf1), materialized<Range2, Output>::make(seq2, ws->buf2),
+                                 output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace);
+    }
+};
+
+template <typename Range1, typename Range2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost, typename Index>
+inline
+typename cost_type<Cost, typename boost::range_value<Range1>::type>::type
+edit_cost_impl(Range1 const& seq1, Range2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, edit_distance_workspace& workspace) {
+    return edit_cost_materialize<Range1, Range2, Output, Cost>::run(seq1, seq2, output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace);
+}
 
 }}}}
 
@@ -0,0 +1,104 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_AUTOMATON_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_AUTOMATON_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/metafunctions.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// The Levenshtein automaton of a query and a max cost (k), under unit costs: it reads a text one
+// element at a time, and accepts the texts within (k) of the query.  Its state after (j) elements
+// is the band of cells [j-k, j+k] of column (j) of the edit distance table, with costs past (k)
+// held at k+1; cells off the band can't come back within (k).  This is the nondeterministic
+// automaton of Schulz and Mihov simulated one state set at a time:
+//     Fast String Correction with Levenshtein-Automata
+//     by Klaus U. Schulz and Stoyan Mihov, International Journal on Document Analysis and Recognition 5, 2002
+// States are arrays of width() costs, kept by the caller, so that one walk over a trie can keep
+// the state of each depth of its path and back up without recomputing
+template <typename Query, typename Equal, typename AllowSub>
+class levenshtein_automaton {
+public:
+    typedef unit_cost::cost_type cost_t;
+    typedef typename boost::remove_cv<typename range_value<Query>::type>::type value_t;
+
+    levenshtein_automaton(Query const& query, const cost_t& k_, const Equal& equal_, const AllowSub& allow_sub)
+        : P(boost::begin(query), boost::end(query)), m(P.size()), k(k_), w(2*k_+1), equal(equal_),
+          sub(sub_checker<AllowSub, unit_cost, cost_t, none>(allow_sub)()) {}
+
+    std::size_t width() const { return w; }
+
+    // the state before any element is read: column zero, the cost of deleting each query prefix
+    void start(cost_t* state) const {
+        for (std::size_t c = 0;  c < w;  ++c) state[c] = (c < k  ||  c-k > m) ? k+1 : c-k;
+    }
+
+    // the state after element (j) (from one) of the text is (v), from the state before it
+    template <typename V>
+    void step(const cost_t* prev, const std::size_t& j, const V& v, cost_t* state) const {
+        for (std::size_t c = 0;  c < w;  ++c) {
+            // query position (i) of cell (c), in column (j)
+            const std::size_t i = j + c;
+            if (i < k  ||  i-k > m) {
+                state[c] = k+1;
+                continue;
+            }
+            const std::size_t qi = i-k;
+            if (qi == 0) {
+                state[c] = std::min(cost_t(j), k+1);
+                continue;
+            }
+            cost_t d = k+1;
+            if (equal(P[qi-1], v)) d = prev[c];
+            else if (sub) d = prev[c]+1;
+            if (c+1 < w) d = std::min(d, prev[c+1]+1);
+            if (c > 0) d = std::min(d, state[c-1]+1);
+            state[c] = std::min(d, k+1);
+        }
+    }
+
+    // the distance of the text read so far from the query, past (k) if it isn't within it
+    cost_t distance(const cost_t* state, const std::size_t& j) const {
+        const std::size_t c = m + k;
+        return (c < j  ||  c-j >= w) ? k+1 : state[c-j];
+    }
+
+    // whether any extension of the text read so far can be within (k)
+    bool live(const cost_t* state) const {
+        return *std::min_element(state, state+w) <= k;
+    }
+
+private:
+    const std::vector<value_t> P;
+    const std::size_t m;
+    const cost_t k;
+    const std::size_t w;
+    Equal equal;
+    const bool sub;
+};
+
+}}}}
+
+#endif
@@ -0,0 +1,197 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_BATCH_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/range/as_literal.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/metafunctions.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// One sequence (the query) to be compared against many others.  In general each comparison is
+// simply a run of the engine for its parameters, in the same workspace
+template <typename Query, typename Cost, typename Equal, typename AllowSub, typename Enable = void>
+class batch_query {
+public:
+    typedef typename cost_type<Cost, typename range_value<Query>::type>::type cost_t;
+
+    batch_query(Query const& query_, const Cost& cost_, const Equal& equal_, const AllowSub& allow_sub_)
+        : query(query_), cost(cost_), equal(equal_), allow_sub(allow_sub_) {}
+
+    template <typename Candidate, typename MaxCost>
+    inline cost_t operator()(Candidate const& candidate, const MaxCost& max_cost, edit_distance_workspace& workspace) const {
+        return edit_cost_impl(query, candidate, nonconst_default<none>(), cost, equal, allow_sub, max_cost, false, nonconst_default<none>(), workspace);
+    }
+
+private:
+    Query const& query;
+    Cost cost;
+    Equal equal;
+    AllowSub allow_sub;
+};
+
+// Under unit costs, for integral elements under default equality, the match masks of the query
+// are built once, and every candidate of the same element type is a text for the bit-parallel
+// engines to run the query over: with substitution the edit distance (see bitparallel_distance
+// and bitparallel_blocked_distance), and without it the longest common subsequence (see
+// bitparallel_lcs).  Other candidates go to the engine as above
+template <typename Query, typename Equal, typename AllowSub>
+class batch_query<Query, unit_cost, Equal, AllowSub,
+                  typename enable_if<and_<is_default_equal<Equal>,
+                                          is_integral<typename range_value<Query>::type>,
+                                          not_<is_same<typename boost::remove_cv<typename range_value<Query>::type>::type, bool> >,
+                                          or_<is_same<AllowSub, boost::true_type>, is_same<AllowSub, boost::false_type> > > >::type> {
+public:
+    typedef unit_cost::cost_type cost_t;
+    typedef typename boost::remove_cv<typename range_value<Query>::type>::type value_t;
+    typedef typename std::vector<value_t>::const_iterator itrp_t;
+    typedef block_match_mask<itrp_t, itrp_t, default_equal> mask_t;
+
+    batch_query(Query const& query_, const unit_cost& cost_, const Equal& equal_, const AllowSub& allow_sub_)
+        : query(query_), equal(equal_), allow_sub(allow_sub_), P(boost::begin(query_), boost::end(query_)), m(P.size()), peq(P.begin(), m, default_equal()) {}
+
+    template <typename Candidate, typename MaxCost>
+    inline cost_t operator()(Candidate const& candidate, const MaxCost& max_cost, edit_distance_workspace& workspace) {
+        typedef typename range_iterator<Candidate const>::type itrt_t;
+        return run(candidate, max_cost, workspace,
+                   integral_constant<bool, is_same<typename std::iterator_traits<itrt_t>::iterator_category, random_access_iterator_tag>::value &&
+                                           is_same<typename boost::remove_cv<typename range_value<Candidate>::type>::type, value_t>::value>());
+    }
+
+private:
+    template <typename Candidate, typename MaxCost>
+    inline cost_t run(Candidate const& candidate, const MaxCost& max_cost, edit_distance_workspace& workspace, false_type) {
+        return edit_cost_impl(query, candidate, nonconst_default<none>(), unit_cost(), equal, allow_sub, max_cost, false, nonconst_default<none>(), workspace);
+    }
+
+    template <typename Candidate, typename MaxCost>
+    cost_t run(Candidate const& candidate, const MaxCost& max_cost, edit_distance_workspace&, true_type) {
+        typedef typename range_iterator<Candidate const>::type itrt_t;
+        const itrt_t T = boost::begin(candidate);
+        const std::ptrdiff_t n = boost::end(candidate) - T;
+        if (m <= 0) return n;
+        if (n <= 0) return m;
+        const max_cost_checker_myers<MaxCost, std::ptrdiff_t, std::ptrdiff_t> max_cost_check(max_cost);
+        return engine_distance(T, n, max_cost_check, allow_sub);
+    }
+
+    template <typename ItrT, typename MaxCostCheck>
+    inline std::ptrdiff_t engine_distance(const ItrT& T, const std::ptrdiff_t& n, const MaxCostCheck& max_cost_check, const boost::true_type&) {
+        if (m <= bitvec_bits) return bitparallel_word_distance(m, T, n, first_block_mask<mask_t>(peq), max_cost_check);
+        return bitparallel_blocked_distance(m, T, n, peq, blocks, max_cost_check);
+    }
+
+    // a difference in length past the max cost leaves the path of all insertions and deletions
+    template <typename ItrT, typename MaxCostCheck>
+    inline std::ptrdiff_t engine_distance(const ItrT& T, const std::ptrdiff_t& n, const MaxCostCheck& max_cost_check, const boost::false_type&) {
+        if (max_cost_check((m < n) ? (n-m) : (m-n))) return m+n;
+        return m + n - 2*bitparallel_lcs(m, T, n, peq, V);
+    }
+
+    Query const& query;
+    Equal equal;
+    AllowSub allow_sub;
+    const std::vector<value_t> P;
+    const std::ptrdiff_t m;
+    const mask_t peq;
+    bitvec_blocks blocks;
+    std::vector<bitvec_t> V;
+};
+
+template <typename Query, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+OutputIterator edit_distance_batch_run(Query const& query, Candidates const& candidates, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, edit_distance_workspace& workspace) {
+    batch_query<Query, Cost, Equal, AllowSub> q(query, cost, equal, allow_sub);
+    for (typename range_iterator<Candidates const>::type c = boost::begin(candidates);  c != boost::end(candidates);  ++c) {
+        *results = q(boost::as_literal(*c), max_cost, workspace);
+        ++results;
+    }
+    return results;
+}
+
+// The bound a candidate must come within to displace the worst of the best so far, at (b): with
+// integral costs it must come in under it, a step short of (b); otherwise up to it
+template <typename CostT>
+inline max_cost_bound<CostT> top_k_bound(const CostT& b) {
+    return max_cost_bound<CostT>(is_integral<CostT>::value ? b - CostT(1) : b);
+}
+
+// a max cost given for the whole scan is only tested against, as is the bound that replaces it
+template <typename MaxCost>
+struct top_k_first {
+    typedef max_cost_bound<MaxCost> type;
+    static inline type make(const MaxCost& max_cost) { return type(max_cost); }
+};
+template <>
+struct top_k_first<none> {
+    typedef none type;
+    static inline type make(const none& max_cost) { return max_cost; }
+};
+
+template <typename CostT>
+inline bool top_k_within(const CostT&, const none&) { return true; }
+template <typename CostT, typename MaxCost>
+inline bool top_k_within(const CostT& d, const max_cost_bound<MaxCost>& max_cost) { return d <= CostT(max_cost_abs(max_cost)); }
+
+// The (n) candidates nearest to a query, kept as a max-heap on distance and position.  Once the heap
+// is full, each later candidate is compared under the distance of the worst of them as a max cost
+// bound, so the engine gives up on it as soon as it can't displace that one: the bound tightens as
+// the scan goes on, and the far candidates, usually most of them, cost little.  Writes the nearest
+// as pairs of position and distance, nearest first, and of equal distances the first in the range
+template <typename Query, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+OutputIterator edit_distance_top_k_run(Query const& query, Candidates const& candidates, const std::size_t& n, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, edit_distance_workspace& workspace) {
+    typedef batch_query<Query, Cost, Equal, AllowSub> query_t;
+    typedef typename query_t::cost_t cost_t;
+    typedef std::pair<cost_t, std::size_t> entry_t;
+    if (n == 0) return results;
+    query_t q(query, cost, equal, allow_sub);
+    const typename top_k_first<MaxCost>::type first = top_k_first<MaxCost>::make(max_cost);
+    std::vector<entry_t> best;
+    std::size_t j = 0;
+    for (typename range_iterator<Candidates const>::type c = boost::begin(candidates);  c != boost::end(candidates);  ++c, ++j) {
+        if (best.size() < n) {
+            const cost_t d = q(boost::as_literal(*c), first, workspace);
+            if (!top_k_within(d, first)) continue;
+            best.push_back(entry_t(d, j));
+            std::push_heap(best.begin(), best.end());
+            continue;
+        }
+        const cost_t b = best.front().first;
+        // nothing comes in under a distance of zero
+        if (b <= cost_t(0)) break;
+        const cost_t d = q(boost::as_literal(*c), top_k_bound(b), workspace);
+        if (!(d < b)) continue;
+        std::pop_heap(best.begin(), best.end());
+        best.back() = entry_t(d, j);
+        std::push_heap(best.begin(), best.end());
+    }
+    std::sort_heap(best.begin(), best.end());
+    for (std::size_t x = 0;  x < best.size();  ++x, ++results) *results = std::make_pair(best[x].second, best[x].first);
+    return results;
+}
+
+}}}}
+
+#endif
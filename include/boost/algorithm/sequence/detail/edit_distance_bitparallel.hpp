@@ -0,0 +1,492 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_BITPARALLEL_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_BITPARALLEL_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+using boost::enable_if;
+using boost::is_same;
+using boost::is_integral;
+using boost::integral_constant;
+using boost::mpl::and_;
+using boost::mpl::not_;
+using std::iterator_traits;
+
+// bit vectors hold one column of the edit graph: bit (i) refers to element (i) of the pattern
+typedef boost::uint64_t bitvec_t;
+const std::ptrdiff_t bitvec_bits = 64;
+
+template <typename T> struct is_byte_value : public
+    integral_constant<bool, is_integral<T>::value && (sizeof(T) == 1) && !is_same<T, bool>::value> {};
+
+// match masks for a pattern of up to bitvec_bits elements:
+// bit (i) of mask(v) is set when pattern element (i) is equal to text element (v)
+template <typename ItrP, typename ItrT, typename Equal, typename Enable = void>
+struct match_mask {
+    ItrP P;
+    std::ptrdiff_t m;
+    Equal equal;
+
+    match_mask(const ItrP& P_, const std::ptrdiff_t& m_, const Equal& equal_) : P(P_), m(m_), equal(equal_) {}
+
+    template <typename V>
+    inline bitvec_t operator()(const V& v) const {
+        bitvec_t r = 0;
+        bitvec_t b = 1;
+        for (std::ptrdiff_t i = 0;  i < m;  ++i, b <<= 1) if (equal(P[i], v)) r |= b;
+        return r;
+    }
+};
+
+// single-byte elements under default equality: masks come from a table, one lookup per text element
+template <typename ItrP, typename ItrT, typename Equal>
+struct match_mask<ItrP, ItrT, Equal,
+                  typename enable_if<and_<is_default_equal<Equal>,
+                                          is_byte_value<typename iterator_traits<ItrP>::value_type>,
+                                          is_same<typename iterator_traits<ItrP>::value_type, typename iterator_traits<ItrT>::value_type> > >::type> {
+    bitvec_t table[256];
+
+    match_mask(const ItrP& P, const std::ptrdiff_t& m, const Equal&) {
+        std::fill(table, table+256, bitvec_t(0));
+        bitvec_t b = 1;
+        for (std::ptrdiff_t i = 0;  i < m;  ++i, b <<= 1) table[static_cast<unsigned char>(P[i])] |= b;
+    }
+
+    template <typename V>
+    inline bitvec_t operator()(const V& v) const { return table[static_cast<unsigned char>(v)]; }
+};
+
+
+// Bit-parallel edit distance (unit cost, with substitution) of a pattern P, |P| = m <= bitvec_bits,
+// against a text T, |T| = n.  Runs in O(n) word operations, with no allocation:
+//     A Fast Bit-Vector Algorithm for Approximate String Matching Based on Dynamic Programming
+//     by Gene Myers, Journal of the ACM 46(3), 1999
+// using the formulation for edit distance (rather than approximate matching) from:
+//     Explaining and Extending the Bit-parallel Approximate String Matching Algorithm of Myers
+//     by Heikki Hyyro, Dept of Computer and Information Sciences, University of Tampere, 2001
+// If the max-cost check shows the distance must exceed the maximum, the algorithm halts early
+// and returns the cost of a (non-minimal) completion, which also exceeds the maximum:
+// either finishing with (n-j-1) insertions, or the all-substitution path of cost max(m,n).
+template <typename ItrT, typename MatchMask, typename MaxCostCheck>
+std::ptrdiff_t bitparallel_word_distance(const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const MatchMask& peq, const MaxCostCheck& max_cost_check) {
+    const bitvec_t last = bitvec_t(1) << (m-1);
+
+    // vertical deltas of the current column, +1 (Pv) and -1 (Mv):  initially D(i,0) = i
+    bitvec_t Pv = ~bitvec_t(0);
+    bitvec_t Mv = 0;
+    std::ptrdiff_t score = m;
+
+    for (std::ptrdiff_t j = 0;  j < n;  ++j) {
+        const bitvec_t Eq = peq(T[j]);
+        const bitvec_t Xv = Eq | Mv;
+        const bitvec_t Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+        bitvec_t Ph = Mv | ~(Xh | Pv);
+        bitvec_t Mh = Pv & Xh;
+        if (Ph & last) ++score;
+        else if (Mh & last) --score;
+        // horizontal delta entering the top row is always +1, since D(0,j) = j
+        Ph = (Ph << 1) | bitvec_t(1);
+        Mh = Mh << 1;
+        Pv = Mh | ~(Xv | Ph);
+        Mv = Ph & Xv;
+
+        // score is D(m,j+1): each of the remaining (n-j-1) columns can lower it by at most 1
+        if (max_cost_check(score - (n-j-1))) return std::min(score + (n-j-1), std::max(m, n));
+    }
+
+    return score;
+}
+
+template <typename ItrP, typename ItrT, typename Equal, typename MaxCostCheck>
+inline std::ptrdiff_t bitparallel_distance(const ItrP& P, const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const Equal& equal, const MaxCostCheck& max_cost_check) {
+    const match_mask<ItrP, ItrT, Equal> peq(P, m, equal);
+    return bitparallel_word_distance(m, T, n, peq, max_cost_check);
+}
+
+
+// match masks for a pattern of any length, as a column of blocks of bitvec_bits elements:
+// bit (t) of mask(v, b) is set when pattern element (b*bitvec_bits + t) is equal to text element (v)
+template <typename ItrP, typename ItrT, typename Equal, typename Enable = void>
+struct block_match_mask {
+    ItrP P;
+    std::ptrdiff_t m;
+    Equal equal;
+
+    block_match_mask(const ItrP& P_, const std::ptrdiff_t& m_, const Equal& equal_) : P(P_), m(m_), equal(equal_) {}
+
+    template <typename V>
+    inline bitvec_t operator()(const V& v, const std::ptrdiff_t& b) const {
+        bitvec_t r = 0;
+        bitvec_t t = 1;
+        const std::ptrdiff_t iend = std::min(m, (b+1)*bitvec_bits);
+        for (std::ptrdiff_t i = b*bitvec_bits;  i < iend;  ++i, t <<= 1) if (equal(P[i], v)) r |= t;
+        return r;
+    }
+};
+
+template <typename ItrP, typename ItrT, typename Equal>
+struct block_match_mask<ItrP, ItrT, Equal,
+                        typename enable_if<and_<is_default_equal<Equal>,
+                                                is_byte_value<typename iterator_traits<ItrP>::value_type>,
+                                                is_same<typename iterator_traits<ItrP>::value_type, typename iterator_traits<ItrT>::value_type> > >::type> {
+    std::ptrdiff_t B;
+    std::vector<bitvec_t> table;
+
+    block_match_mask(const ItrP& P, const std::ptrdiff_t& m, const Equal&) : B((m + bitvec_bits-1) / bitvec_bits), table(256*B, bitvec_t(0)) {
+        for (std::ptrdiff_t i = 0;  i < m;  ++i) {
+            table[static_cast<unsigned char>(P[i])*B + i/bitvec_bits] |= bitvec_t(1) << (i%bitvec_bits);
+        }
+    }
+
+    template <typename V>
+    inline bitvec_t operator()(const V& v, const std::ptrdiff_t& b) const { return table[static_cast<unsigned char>(v)*B + b]; }
+};
+
+// wider integral elements under default equality: the distinct elements of the pattern are kept
+// sorted, each with a row of masks, and a text element finds its row by binary search
+template <typename ItrP, typename ItrT, typename Equal>
+struct block_match_mask<ItrP, ItrT, Equal,
+                        typename enable_if<and_<is_default_equal<Equal>,
+                                                is_integral<typename iterator_traits<ItrP>::value_type>,
+                                                not_<is_same<typename iterator_traits<ItrP>::value_type, bool> >,
+                                                not_<is_byte_value<typename iterator_traits<ItrP>::value_type> >,
+                                                is_same<typename iterator_traits<ItrP>::value_type, typename iterator_traits<ItrT>::value_type> > >::type> {
+    typedef typename iterator_traits<ItrP>::value_type value_t;
+    std::ptrdiff_t B;
+    std::vector<value_t> symbols;
+    std::vector<bitvec_t> table;
+
+    block_match_mask(const ItrP& P, const std::ptrdiff_t& m, const Equal&) : B((m + bitvec_bits-1) / bitvec_bits), symbols(P, P+m) {
+        std::sort(symbols.begin(), symbols.end());
+        symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+        table.assign(symbols.size()*B, bitvec_t(0));
+        for (std::ptrdiff_t i = 0;  i < m;  ++i) {
+            const std::ptrdiff_t s = std::lower_bound(symbols.begin(), symbols.end(), P[i]) - symbols.begin();
+            table[s*B + i/bitvec_bits] |= bitvec_t(1) << (i%bitvec_bits);
+        }
+    }
+
+    inline bitvec_t operator()(const value_t& v, const std::ptrdiff_t& b) const {
+        const typename std::vector<value_t>::const_iterator s = std::lower_bound(symbols.begin(), symbols.end(), v);
+        if (s == symbols.end()  ||  !(*s == v)) return bitvec_t(0);
+        return table[(s - symbols.begin())*B + b];
+    }
+};
+
+// the masks of the first block, for a pattern that fits in one
+template <typename BlockMatchMask>
+struct first_block_mask {
+    const BlockMatchMask& peq;
+    explicit first_block_mask(const BlockMatchMask& peq_) : peq(peq_) {}
+
+    template <typename V>
+    inline bitvec_t operator()(const V& v) const { return peq(v, 0); }
+};
+
+// advance one block of a bit-parallel column, given the horizontal delta 'hin' entering its top row.
+// returns the horizontal delta leaving the row whose bit is 'hbit' (the bottom row of the block)
+inline int bitparallel_block(bitvec_t& Pv, bitvec_t& Mv, bitvec_t Eq, const int hin, const bitvec_t& hbit) {
+    const bitvec_t Xv = Eq | Mv;
+    // a -1 entering the top row acts like a match there
+    if (hin < 0) Eq |= bitvec_t(1);
+    const bitvec_t Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+    bitvec_t Ph = Mv | ~(Xh | Pv);
+    bitvec_t Mh = Pv & Xh;
+    int hout = 0;
+    if (Ph & hbit) hout = 1;
+    else if (Mh & hbit) hout = -1;
+    Ph <<= 1;
+    Mh <<= 1;
+    if (hin < 0) Mh |= bitvec_t(1);
+    else if (hin > 0) Ph |= bitvec_t(1);
+    Pv = Mh | ~(Xv | Ph);
+    Mv = Ph & Xv;
+    return hout;
+}
+
+inline std::ptrdiff_t bitvec_popcount(bitvec_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return std::ptrdiff_t((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// working storage for the blocked engine, so it can be re-used across passes
+struct bitvec_blocks {
+    std::vector<bitvec_t> Pv;
+    std::vector<bitvec_t> Mv;
+    std::vector<std::ptrdiff_t> score;
+
+    inline void resize(const std::ptrdiff_t& B) {
+        Pv.resize(B);
+        Mv.resize(B);
+        score.resize(B);
+    }
+};
+
+// column observer for the blocked engine that watches nothing
+struct bitvec_no_observer {
+    inline bool operator()(const std::ptrdiff_t&, const std::ptrdiff_t&, const std::ptrdiff_t&, const bitvec_blocks&) const { return true; }
+};
+
+// Blocked bit-parallel edit distance (unit cost, with substitution) of a pattern of any length m,
+// against a text T of length n, computing only the blocks that may hold an edit path of cost <= k:
+//     A Fast Bit-Vector Algorithm for Approximate String Matching Based on Dynamic Programming
+//     by Gene Myers, Journal of the ACM 46(3), 1999  (section 5: the blocks-based algorithm)
+// with the band restricted using the cutoff ideas of:
+//     Algorithms for Approximate String Matching
+//     by Esko Ukkonen, Information and Control 64, 1985
+//
+// Two cutoffs apply at each column.  A cell (i,j) whose diagonal puts it too far from both corners
+// of the edit graph can't be on a path of cost <= k, which yields a static diagonal band.  And once
+// every cell of the first or last active block is known to exceed k, that block is dropped.
+// Cells outside the band are never read: blocks assume a +1 delta entering from above, and new
+// blocks start as a column of +1 deltas, so every computed value is the cost of some real edit path,
+// and is exact for any cell on a path of cost <= k.
+//
+// Returns D(m,n) if it is <= k, otherwise the cost (> k) of some valid, non-minimal, edit path.
+// After each column (j), observe(j, first, last, blocks) is shown the active blocks [first, last];
+// if it returns false the computation stops there.
+template <typename ItrT, typename MatchMask, typename Observer>
+std::ptrdiff_t bitparallel_banded_distance(const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const MatchMask& peq, bitvec_blocks& blocks, const std::ptrdiff_t& k, Observer& observe) {
+    typedef std::ptrdiff_t diff_type;
+
+    // the all-substitution (plus indels) path is always available
+    diff_type ub = std::max(m, n);
+
+    // the difference in lengths is a lower bound on cost
+    const diff_type delta = n-m;
+    const diff_type adelta = (delta < 0) ? -delta : delta;
+    if (adelta > k) return ub;
+
+    // static band: cell (i,j) lies on diagonal (j-i), in [dlo, dhi]
+    const diff_type e = (k - adelta) / 2;
+    const diff_type dlo = std::min(diff_type(0), delta) - e;
+    const diff_type dhi = std::max(diff_type(0), delta) + e;
+
+    const diff_type B = (m + bitvec_bits-1) / bitvec_bits;
+    const diff_type hlast = m - (B-1)*bitvec_bits;
+    blocks.resize(B);
+    bitvec_t* const Pv = &blocks.Pv[0];
+    bitvec_t* const Mv = &blocks.Mv[0];
+    diff_type* const score = &blocks.score[0];
+
+    // active blocks are [first, last]
+    diff_type first = 0;
+    diff_type last = -1;
+    for (diff_type j = 1;  j <= n;  ++j) {
+        // add blocks entering the band at the bottom, from a column of +1 deltas at column (j-1)
+        const diff_type lb = (std::min(m, j - dlo) - 1) / bitvec_bits;
+        while (last < lb) {
+            const diff_type prev = (last < 0) ? (j-1) : score[last];
+            ++last;
+            Pv[last] = ~bitvec_t(0);
+            Mv[last] = 0;
+            score[last] = prev + ((last == B-1) ? hlast : bitvec_bits);
+        }
+        // drop blocks leaving the band at the top
+        const diff_type fb = (std::max(diff_type(1), j - dhi) - 1) / bitvec_bits;
+        if (first < fb) first = fb;
+
+        // compute column (j) over active blocks
+        const typename std::iterator_traits<ItrT>::value_type& v = T[j-1];
+        int h = 1;
+        for (diff_type b = first;  b <= last;  ++b) {
+            const bitvec_t hbit = bitvec_t(1) << (((b == B-1) ? hlast : bitvec_bits) - 1);
+            h = bitparallel_block(Pv[b], Mv[b], peq(v, b), h, hbit);
+            score[b] += h;
+        }
+
+        // the cells of a block are all within (height-1) of its bottom row:
+        // drop end blocks whose every cell must exceed k
+        while (first <= last) {
+            const diff_type hb = (first == B-1) ? hlast : bitvec_bits;
+            if (score[first] - (hb-1) <= k) break;
+            ub = std::min(ub, score[first] + std::max(m - (first*bitvec_bits + hb), n - j));
+            ++first;
+        }
+        while (last >= first) {
+            const diff_type hb = (last == B-1) ? hlast : bitvec_bits;
+            if (score[last] - (hb-1) <= k) break;
+            ub = std::min(ub, score[last] + std::max(m - (last*bitvec_bits + hb), n - j));
+            --last;
+        }
+        if (first > last) return ub;
+        if (!observe(j, first, last, blocks)) return ub;
+    }
+
+    // the last block's bottom row is row (m)
+    if (last == B-1) return std::min(ub, score[last]);
+    for (diff_type b = first;  b <= last;  ++b) ub = std::min(ub, score[b] + (m - (b+1)*bitvec_bits));
+    return ub;
+}
+
+template <typename ItrT, typename MatchMask>
+inline std::ptrdiff_t bitparallel_banded_distance(const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const MatchMask& peq, bitvec_blocks& blocks, const std::ptrdiff_t& k) {
+    bitvec_no_observer observe;
+    return bitparallel_banded_distance(m, T, n, peq, blocks, k, observe);
+}
+
+// The banded engine over a band that starts narrow, and doubles until it holds the distance.  A max
+// cost caps the band, and once the band covers the longer sequence, the result is exact regardless
+template <typename ItrT, typename MatchMask, typename MaxCostCheck>
+std::ptrdiff_t bitparallel_blocked_distance(const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const MatchMask& peq, bitvec_blocks& blocks, const MaxCostCheck& max_cost_check) {
+    const std::ptrdiff_t kmax = max_cost_check.cap(std::max(m, n));
+    std::ptrdiff_t k = std::min(kmax, std::abs(n-m) + bitvec_bits);
+    while (true) {
+        const std::ptrdiff_t D = bitparallel_banded_distance(m, T, n, peq, blocks, k);
+        if (D <= k  ||  k >= kmax) return D;
+        k = std::min(kmax, 2*k);
+    }
+}
+
+// upper bound on the number of active blocks in any column of the banded engine
+inline std::ptrdiff_t bitparallel_band_blocks(const std::ptrdiff_t& m, const std::ptrdiff_t& n, const std::ptrdiff_t& k) {
+    const std::ptrdiff_t B = (m + bitvec_bits-1) / bitvec_bits;
+    const std::ptrdiff_t adelta = (n < m) ? (m-n) : (n-m);
+    const std::ptrdiff_t width = adelta + 2*(std::max(std::ptrdiff_t(0), k - adelta) / 2);
+    return std::min(B, width/bitvec_bits + 2);
+}
+
+// the value of cell (i) in a column, given the active blocks that hold it: the bottom row of each
+// block holds its score, and rows above it are recovered by backing out the vertical deltas
+inline std::ptrdiff_t bitvec_cell(const std::ptrdiff_t& m, const std::ptrdiff_t& i, const std::ptrdiff_t& b, const bitvec_t& Pv, const bitvec_t& Mv, const std::ptrdiff_t& score) {
+    const std::ptrdiff_t hb = std::min(m - b*bitvec_bits, bitvec_bits);
+    const std::ptrdiff_t r = i - b*bitvec_bits;
+    if (r >= hb) return score;
+    bitvec_t mask = ~bitvec_t(0) << r;
+    if (hb < bitvec_bits) mask &= (bitvec_t(1) << hb) - 1;
+    return score - bitvec_popcount(Pv & mask) + bitvec_popcount(Mv & mask);
+}
+
+// Observes the banded engine to snapshot column (jcol): col[i] = D(i,jcol), or 'inf' outside the
+// active blocks.  Every value is the cost of some real edit path, exact for cells on a path of cost <= k
+struct bitvec_column_snapshot {
+    std::ptrdiff_t m;
+    std::ptrdiff_t jcol;
+    std::ptrdiff_t inf;
+    std::vector<std::ptrdiff_t>& col;
+
+    bitvec_column_snapshot(const std::ptrdiff_t& m_, const std::ptrdiff_t& jcol_, const std::ptrdiff_t& inf_, std::vector<std::ptrdiff_t>& col_) : m(m_), jcol(jcol_), inf(inf_), col(col_) {}
+
+    bool operator()(const std::ptrdiff_t& j, const std::ptrdiff_t& first, const std::ptrdiff_t& last, const bitvec_blocks& blocks) {
+        if (j < jcol) return true;
+        col.assign(m+1, inf);
+        col[0] = j;
+        for (std::ptrdiff_t b = first;  b <= last;  ++b) {
+            const std::ptrdiff_t iend = std::min(m, (b+1)*bitvec_bits);
+            for (std::ptrdiff_t i = b*bitvec_bits + 1;  i <= iend;  ++i) {
+                col[i] = bitvec_cell(m, i, b, blocks.Pv[b], blocks.Mv[b], blocks.score[b]);
+            }
+        }
+        return false;
+    }
+};
+
+// Observes the banded engine to keep the active blocks of every column, so that any computed cell
+// D(i,j) can be read back for a traceback.  Cells outside the stored blocks read as 'inf'
+struct bitvec_trace {
+    std::ptrdiff_t m;
+    std::ptrdiff_t inf;
+    std::vector<std::ptrdiff_t> first;
+    std::vector<std::ptrdiff_t> last;
+    std::vector<std::ptrdiff_t> offset;
+    std::vector<bitvec_t> Pv;
+    std::vector<bitvec_t> Mv;
+    std::vector<std::ptrdiff_t> score;
+
+    bitvec_trace(const std::ptrdiff_t& m_, const std::ptrdiff_t& n, const std::ptrdiff_t& blocks_per_column, const std::ptrdiff_t& inf_) : m(m_), inf(inf_) {
+        first.reserve(n);
+        last.reserve(n);
+        offset.reserve(n);
+        Pv.reserve(n*blocks_per_column);
+        Mv.reserve(n*blocks_per_column);
+        score.reserve(n*blocks_per_column);
+    }
+
+    bool operator()(const std::ptrdiff_t&, const std::ptrdiff_t& f, const std::ptrdiff_t& l, const bitvec_blocks& blocks) {
+        first.push_back(f);
+        last.push_back(l);
+        offset.push_back(Pv.size());
+        Pv.insert(Pv.end(), blocks.Pv.begin()+f, blocks.Pv.begin()+(l+1));
+        Mv.insert(Mv.end(), blocks.Mv.begin()+f, blocks.Mv.begin()+(l+1));
+        score.insert(score.end(), blocks.score.begin()+f, blocks.score.begin()+(l+1));
+        return true;
+    }
+
+    inline std::ptrdiff_t operator()(const std::ptrdiff_t& i, const std::ptrdiff_t& j) const {
+        if (j <= 0) return i;
+        if (i <= 0) return j;
+        const std::ptrdiff_t b = (i-1) / bitvec_bits;
+        if (b < first[j-1]  ||  b > last[j-1]) return inf;
+        const std::ptrdiff_t x = offset[j-1] + (b - first[j-1]);
+        return bitvec_cell(m, i, b, Pv[x], Mv[x], score[x]);
+    }
+};
+
+
+// Bit-parallel length of the longest common subsequence of a pattern of any length m, and a text T:
+//     A Bit-String Longest-Common-Subsequence Algorithm
+//     by Lloyd Allison and Trevor I. Dix, Information Processing Letters 23, 1986
+// in the simplified form from:
+//     Bit-Parallel LCS-length Computation Revisited
+//     by Heikki Hyyro, Proceedings of AWOCA 2004
+// The cost is O(n*ceil(m/w)) word operations, whatever the number of differences: the insertion
+// and deletion (no substitution) distance is then just m + n - 2*LCS.
+// Each zero bit of V marks a pattern element matched by the LCS; bits of the last block beyond
+// (m) never see a match, so they stay set and don't disturb the count.
+template <typename ItrT, typename MatchMask>
+std::ptrdiff_t bitparallel_lcs(const std::ptrdiff_t& m, const ItrT& T, const std::ptrdiff_t& n, const MatchMask& peq, std::vector<bitvec_t>& V) {
+    const std::ptrdiff_t B = (m + bitvec_bits-1) / bitvec_bits;
+    V.assign(B, ~bitvec_t(0));
+    bitvec_t* const Vb = &V[0];
+
+    for (std::ptrdiff_t j = 0;  j < n;  ++j) {
+        const typename std::iterator_traits<ItrT>::value_type& v = T[j];
+        bitvec_t carry = 0;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) {
+            const bitvec_t U = Vb[b] & peq(v, b);
+            // multi-word addition (V + U), with carry across blocks
+            const bitvec_t s = Vb[b] + U;
+            const bitvec_t x = s + carry;
+            carry = bitvec_t((s < Vb[b]) | (x < s));
+            Vb[b] = x | (Vb[b] - U);
+        }
+    }
+
+    std::ptrdiff_t ones = 0;
+    for (std::ptrdiff_t b = 0;  b < B;  ++b) ones += bitvec_popcount(Vb[b]);
+    return B*bitvec_bits - ones;
+}
+
+
+}}}}
+
+#endif
@@ -0,0 +1,190 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_DIAGONAL_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_DIAGONAL_HPP
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_bitparallel.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_snake.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// Unit cost edit distance with substitution, by furthest-reaching diagonals:
+//     Algorithms for Approximate String Matching
+//     by Esko Ukkonen
+//     Fast Parallel and Serial Approximate String Matching
+//     by Gad M. Landau and Uzi Vishkin
+// Diagonal (k) holds the cells (j1, j1-k).  Along a diagonal the distance from the origin never
+// decreases, so after round (d) each diagonal is summed up by the furthest j1 it reaches at a
+// cost <= d.  Round (d) extends every diagonal by one substitution, insertion or deletion from
+// round (d-1), and then along its snake.  Reaching (L1,L2) at round D takes O((L1+L2)D) time
+// at worst, and O(L1+L2+D^2) on sequences that differ at random.
+
+// positions run from the beginning of both sequences
+struct diagonal_forward {
+    template <typename Itr1, typename Itr2, typename Equal>
+    static inline std::ptrdiff_t snake(const Itr1& S1, const std::ptrdiff_t& L1, const Itr2& S2, const std::ptrdiff_t& L2, const std::ptrdiff_t& j1, const std::ptrdiff_t& j2, const Equal& equal) {
+        return snake_forward(S1+j1, S2+j2, std::min(L1-j1, L2-j2), equal);
+    }
+};
+
+// positions run back from the end of both sequences
+struct diagonal_reverse {
+    template <typename Itr1, typename Itr2, typename Equal>
+    static inline std::ptrdiff_t snake(const Itr1& S1, const std::ptrdiff_t& L1, const Itr2& S2, const std::ptrdiff_t& L2, const std::ptrdiff_t& j1, const std::ptrdiff_t& j2, const Equal& equal) {
+        return snake_reverse(S1+(L1-j1), S2+(L2-j2), std::min(L1-j1, L2-j2), equal);
+    }
+};
+
+template <typename Itr1, typename Itr2, typename Equal, typename Direction>
+struct furthest_reaching {
+    typedef std::ptrdiff_t diff_type;
+    typedef std::vector<diff_type>::iterator itrv_t;
+
+    const Itr1 S1;
+    const diff_type L1;
+    const Itr2 S2;
+    const diff_type L2;
+    const Equal& equal;
+
+    // the last completed round
+    diff_type d;
+    // V[k + L2+1], for diagonals (k) in [-L2, L1], with an unreached sentinel either side
+    std::vector<diff_type>& V;
+    // the diagonals searched
+    diff_type klo;
+    diff_type khi;
+
+    static diff_type unreached() { return std::numeric_limits<diff_type>::min() / 2; }
+
+    // Only the diagonals on a path of cost <= (b) are searched: reaching diagonal (k) costs at least |k|,
+    // and leaving it for (L1,L2) at least |(L1-L2)-k|.  Only their entries of V (and a sentinel either
+    // side) are set
+    furthest_reaching(const Itr1& S1_, const diff_type& L1_, const Itr2& S2_, const diff_type& L2_, const Equal& equal_, std::vector<diff_type>& V_, const diff_type& b)
+        : S1(S1_), L1(L1_), S2(S2_), L2(L2_), equal(equal_), d(-1), V(V_),
+          klo(std::max(-L2_, -((b-(L1_-L2_))/2))), khi(std::min(L1_, (b+(L1_-L2_))/2)) {
+        V.resize(L1+L2+3);
+        if (klo <= khi) std::fill(V.begin() + (klo+L2), V.begin() + (khi+L2+3), unreached());
+    }
+
+    furthest_reaching(const Itr1& S1_, const diff_type& L1_, const Itr2& S2_, const diff_type& L2_, const Equal& equal_, std::vector<diff_type>& V_)
+        : S1(S1_), L1(L1_), S2(S2_), L2(L2_), equal(equal_), d(-1), V(V_), klo(-L2_), khi(L1_) {
+        V.assign(L1+L2+3, unreached());
+    }
+
+    inline diff_type lo() const { return std::max(-d, klo); }
+    inline diff_type hi() const { return std::min(d, khi); }
+    inline diff_type reach(const diff_type& k) const { return V[k+L2+1]; }
+
+    // run round (d+1), and report whether it reaches (L1,L2)
+    bool next() {
+        ++d;
+        const itrv_t Vk = V.begin() + (L2+1);
+        if (d == 0) {
+            Vk[0] = Direction::snake(S1, L1, S2, L2, 0, 0, equal);
+            return Vk[0] >= L1  &&  L1 == L2;
+        }
+        diff_type prev = Vk[lo()-1];
+        for (diff_type k = lo();  k <= hi();  ++k) {
+            const diff_type cur = Vk[k];
+            diff_type j1 = unreached();
+            // substitution, or staying put at the end of either sequence
+            if (cur != unreached()) j1 = (cur < L1  &&  cur-k < L2) ? cur+1 : cur;
+            // deletion, from diagonal (k-1)
+            if (prev != unreached()  &&  prev < L1) j1 = std::max(j1, prev+1);
+            // insertion, from diagonal (k+1)
+            const diff_type next = Vk[k+1];
+            if (next != unreached()  &&  next-(k+1) < L2) j1 = std::max(j1, next);
+            // a new diagonal can't be entered from one that already ends at a sequence end
+            if (j1 != unreached()) Vk[k] = j1 + Direction::snake(S1, L1, S2, L2, j1, j1-k, equal);
+            prev = cur;
+        }
+        return (L1-L2) >= lo()  &&  (L1-L2) <= hi()  &&  Vk[L1-L2] >= L1;
+    }
+
+    // the cost of a valid, non-minimal, path: the best reach so far, completed with substitutions and indels
+    diff_type completion() const {
+        diff_type c = std::max(L1, L2);
+        for (diff_type k = lo();  k <= hi();  ++k) {
+            const diff_type j1 = reach(k);
+            if (j1 != unreached()) c = std::min(c, d + std::max(L1-j1, L2-(j1-k)));
+        }
+        return c;
+    }
+};
+
+// Round (d) of the diagonal algorithm costs O(d) steps plus snakes, where a bit-parallel band wide
+// enough for distance (d) costs O(n d/w) for the whole computation: past the crossover the latter wins
+inline bool diagonal_preferred(const std::ptrdiff_t& L1, const std::ptrdiff_t& L2, const std::ptrdiff_t& d) {
+    return d*d <= 256 + std::max(L1, L2) * (1 + (d)/bitvec_bits);
+}
+
+// The distance by furthest-reaching diagonals, or -1 if it grows past the crossover first.  If the
+// max-cost check shows the distance must exceed the maximum, returns the cost of a completion (or
+// just a lower bound, past a max cost bound).  The diagonals are kept in (V)
+template <typename Itr1, typename Itr2, typename Equal, typename MaxCostCheck>
+std::ptrdiff_t diagonal_distance(const Itr1& S1, const std::ptrdiff_t& L1, const Itr2& S2, const std::ptrdiff_t& L2, const Equal& equal, const MaxCostCheck& max_cost_check, std::vector<std::ptrdiff_t>& V) {
+    furthest_reaching<Itr1, Itr2, Equal, diagonal_forward> F(S1, L1, S2, L2, equal, V, (max_cost_check.bounded()) ? max_cost_check.cap(L1+L2) : L1+L2);
+    while (diagonal_preferred(L1, L2, F.d+1)) {
+        if (F.next()) return F.d;
+        // the distance is at least d+1
+        if (max_cost_check(F.d+1)) return (max_cost_check.bounded()) ? F.d+1 : F.completion();
+    }
+    return -1;
+}
+
+// Given the distance (D >= 2) of two sequences, find a cell (x1,x2) on a best path, with
+// D(0,0 -> x1,x2) = ceil(D/2).  On any diagonal where the forward reach of round ceil(D/2) meets
+// the reverse reach of round floor(D/2), every cell in between lies on such a path
+template <typename Itr1, typename Itr2, typename Equal>
+void diagonal_midpoint(const Itr1& S1, const std::ptrdiff_t& L1, const Itr2& S2, const std::ptrdiff_t& L2, const std::ptrdiff_t& D, const Equal& equal, std::ptrdiff_t& x1, std::ptrdiff_t& x2) {
+    typedef std::ptrdiff_t diff_type;
+    std::vector<diff_type> VF, VR;
+    furthest_reaching<Itr1, Itr2, Equal, diagonal_forward> F(S1, L1, S2, L2, equal, VF);
+    furthest_reaching<Itr1, Itr2, Equal, diagonal_reverse> R(S1, L1, S2, L2, equal, VR);
+    const diff_type df = (D+1)/2;
+    while (F.d < df) F.next();
+    while (R.d < D-df) R.next();
+
+    // diagonal (k) runs backward as diagonal (L1-L2-k)
+    for (diff_type k = F.lo();  k <= F.hi();  ++k) {
+        const diff_type kr = (L1-L2) - k;
+        if (kr < R.lo()  ||  kr > R.hi()) continue;
+        const diff_type f = F.reach(k);
+        const diff_type r = R.reach(kr);
+        if (f == F.unreached()  ||  r == R.unreached()) continue;
+        if (f >= L1-r) {
+            x1 = f;
+            x2 = f-k;
+            return;
+        }
+    }
+
+    // control should not reach here
+    BOOST_ASSERT(false);
+    x1 = x2 = 0;
+}
+
+
+}}}}
+
+#endif
@@ -0,0 +1,197 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_FILTER_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_FILTER_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/distance.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/metafunctions.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_workspace.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+// Counts of the pairs that edit_distance_within() put through its lower bound filters, and of those
+// each filter rejected, in the order they are tried.  Passed with the _filter_stats parameter
+struct edit_distance_filter_stats {
+    std::size_t tested;
+    std::size_t length;
+    std::size_t histogram;
+    std::size_t qgram;
+
+    edit_distance_filter_stats() : tested(0), length(0), histogram(0), qgram(0) {}
+
+    void clear() { *this = edit_distance_filter_stats(); }
+
+    // the pairs left for an engine to decide
+    std::size_t passed() const { return tested - length - histogram - qgram; }
+};
+
+namespace detail {
+
+using boost::distance;
+using boost::integral_constant;
+using boost::is_same;
+using boost::is_arithmetic;
+using boost::range_iterator;
+using boost::range_value;
+using boost::mpl::and_;
+
+// length of the q-grams counted by the q-gram filter
+enum { filter_qgram_length = 3 };
+
+// Counts of q-grams hashed into buckets.  Q-grams that share a bucket only ever hide differences,
+// so the bounds drawn from these counts stay lower bounds.  Buckets are returned to zero after
+// each use, so only the buckets touched are ever visited
+struct qgram_counts {
+    enum { bits = 12, buckets = 1 << bits };
+    std::vector<int> count;
+    qgram_counts() : count(buckets, 0) {}
+};
+
+// The bucket of each q-gram in turn, rolled along the sequence: each element is shifted out of
+// the bucket bits once q more have come in, so that a bucket depends on its q-gram only
+template <typename Itr>
+class qgram_roll {
+public:
+    qgram_roll(const Itr& j_, const std::ptrdiff_t& q) : j(j_), h(0), shift(qgram_counts::bits/q) {
+        for (std::ptrdiff_t k = 1;  k < q;  ++k) next();
+    }
+    inline std::size_t next() {
+        h = ((h << shift) ^ hash(*j)) & (qgram_counts::buckets-1);
+        ++j;
+        return h;
+    }
+
+private:
+    Itr j;
+    std::size_t h;
+    const std::size_t shift;
+    boost::hash<typename boost::remove_cv<typename std::iterator_traits<Itr>::value_type>::type> hash;
+};
+
+// the number of q-grams (counting multiplicity) that seq1 and seq2 have in common, or at least
+// no fewer than that
+template <typename Range1, typename Range2>
+std::ptrdiff_t shared_qgrams(Range1 const& seq1, const std::ptrdiff_t& L1, Range2 const& seq2, const std::ptrdiff_t& L2, const std::ptrdiff_t& q, std::vector<int>& count) {
+    typedef qgram_roll<typename range_iterator<Range1 const>::type> roll1_t;
+    typedef qgram_roll<typename range_iterator<Range2 const>::type> roll2_t;
+    const std::ptrdiff_t n1 = L1-q+1;
+    const std::ptrdiff_t n2 = L2-q+1;
+    if (n1 <= 0  ||  n2 <= 0) return 0;
+
+    roll1_t r1(boost::begin(seq1), q);
+    for (std::ptrdiff_t k = 0;  k < n1;  ++k) ++count[r1.next()];
+    std::ptrdiff_t shared = 0;
+    roll2_t r2(boost::begin(seq2), q);
+    for (std::ptrdiff_t k = 0;  k < n2;  ++k) {
+        int& c = count[r2.next()];
+        if (c > 0) ++shared;
+        --c;
+    }
+
+    roll1_t z1(boost::begin(seq1), q);
+    for (std::ptrdiff_t k = 0;  k < n1;  ++k) count[z1.next()] = 0;
+    roll2_t z2(boost::begin(seq2), q);
+    for (std::ptrdiff_t k = 0;  k < n2;  ++k) count[z2.next()] = 0;
+    return shared;
+}
+
+inline void filter_count(none&, std::size_t edit_distance_filter_stats::*) {}
+inline void filter_count(edit_distance_filter_stats& stats, std::size_t edit_distance_filter_stats::* c) { ++(stats.*c); }
+
+// Lower bounds on the distance, tried in turn against a maximum cost, each in time linear in the
+// length of the sequences: returns false when one of them shows the distance is over (max_cost).
+// Outside of unit costs no bound applies
+template <typename Cost, typename Equal>
+struct lower_bound_filter {
+    template <typename Range1, typename Range2, typename AllowSub, typename MaxCost, typename Stats>
+    static inline bool within(Range1 const&, Range2 const&, const AllowSub&, const MaxCost&, edit_distance_workspace&, Stats&) {
+        return true;
+    }
+};
+
+// Under unit costs the distance is at least the difference in length.  Where elements can also be
+// hashed consistently with their equality, each edit changes the counts of at most one element on
+// either side, and destroys at most q of the q-grams of either sequence:
+//     Approximate String-Matching with q-grams and Maximal Matches
+//     by Esko Ukkonen
+// The counts take passes over both sequences, which cost more than the diagonal and bit-parallel
+// engines take to give up on a pair (they stop after max_cost rounds), so they are taken only
+// ahead of the Dijkstra engine, where substitution is decided at run time
+template <typename Equal>
+struct lower_bound_filter<unit_cost, Equal> {
+    template <typename Range1, typename Range2, typename AllowSub>
+    struct counted : public and_<is_default_equal<Equal>,
+                                 is_same<AllowSub, bool>,
+                                 is_same<typename boost::remove_cv<typename range_value<Range1>::type>::type, typename boost::remove_cv<typename range_value<Range2>::type>::type>,
+                                 is_arithmetic<typename range_value<Range1>::type> > {};
+
+    template <typename Range1, typename Range2, typename AllowSub, typename MaxCost, typename Stats>
+    static inline bool within(Range1 const& seq1, Range2 const& seq2, const AllowSub& allow_sub, const MaxCost& max_cost, edit_distance_workspace& workspace, Stats& stats) {
+        const std::ptrdiff_t L1 = std::ptrdiff_t(distance(seq1));
+        const std::ptrdiff_t L2 = std::ptrdiff_t(distance(seq2));
+        const std::ptrdiff_t k = std::ptrdiff_t(max_cost_abs(max_cost));
+        filter_count(stats, &edit_distance_filter_stats::tested);
+        if (max_cost_abs(L1-L2) > k) {
+            filter_count(stats, &edit_distance_filter_stats::length);
+            return false;
+        }
+        return counts_within(seq1, L1, seq2, L2, sub_checker<AllowSub, unit_cost, std::size_t, none>(allow_sub)(), k, workspace, stats, integral_constant<bool, counted<Range1, Range2, AllowSub>::value>());
+    }
+
+    template <typename Range1, typename Range2, typename Stats>
+    static inline bool counts_within(Range1 const&, const std::ptrdiff_t&, Range2 const&, const std::ptrdiff_t&, const bool, const std::ptrdiff_t&, edit_distance_workspace&, Stats&, false_type) {
+        return true;
+    }
+
+    template <typename Range1, typename Range2, typename Stats>
+    static bool counts_within(Range1 const& seq1, const std::ptrdiff_t& L1, Range2 const& seq2, const std::ptrdiff_t& L2, const bool sub, const std::ptrdiff_t& k, edit_distance_workspace& workspace, Stats& stats, true_type) {
+        workspace_lease<qgram_counts> counts(workspace);
+
+        // elements of either sequence missing from the other: a substitution accounts for one of
+        // each, an insertion or deletion for one only
+        std::ptrdiff_t shared = shared_qgrams(seq1, L1, seq2, L2, 1, counts->count);
+        const std::ptrdiff_t m1 = L1-shared;
+        const std::ptrdiff_t m2 = L2-shared;
+        if ((sub ? std::max(m1, m2) : m1+m2) > k) {
+            filter_count(stats, &edit_distance_filter_stats::histogram);
+            return false;
+        }
+
+        const std::ptrdiff_t q = filter_qgram_length;
+        shared = shared_qgrams(seq1, L1, seq2, L2, q, counts->count);
+        const std::ptrdiff_t g1 = std::max(L1-q+1, std::ptrdiff_t(0)) - shared;
+        const std::ptrdiff_t g2 = std::max(L2-q+1, std::ptrdiff_t(0)) - shared;
+        if (std::max(g1, g2) > q*k) {
+            filter_count(stats, &edit_distance_filter_stats::qgram);
+            return false;
+        }
+        return true;
+    }
+};
+
+}}}}
+
+#endif
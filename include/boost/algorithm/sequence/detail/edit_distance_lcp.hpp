@@ -0,0 +1,478 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_LCP_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_LCP_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/distance.hpp>
+#include <boost/range/metafunctions.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_snake.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// Suffix array construction by induced sorting, in O(n) time:
+//     Two Efficient Algorithms for Linear Time Suffix Array Construction
+//     by Ge Nong, Sen Zhang and Wai Hong Chan
+// The symbols of (s) lie in [0, upper]
+struct suffix_array_is {
+    typedef boost::int32_t int_type;
+
+    const std::vector<int_type>& s;
+    const int_type n;
+    const int_type upper;
+    std::vector<int_type>& sa;
+    // ls[i] is true where suffix (i) is S-type (less than suffix i+1)
+    std::vector<bool> ls;
+    std::vector<int_type> sum_l;
+    std::vector<int_type> sum_s;
+
+    suffix_array_is(const std::vector<int_type>& s_, const int_type& upper_, std::vector<int_type>& sa_)
+        : s(s_), n(s_.size()), upper(upper_), sa(sa_) {}
+
+    // place the LMS suffixes (lms) at the ends of their buckets, then induce the L-type suffixes
+    // from the left and the S-type suffixes from the right
+    void induce(const std::vector<int_type>& lms) {
+        std::fill(sa.begin(), sa.end(), int_type(-1));
+        std::vector<int_type> buf(sum_s);
+        for (std::size_t j = 0;  j < lms.size();  ++j) {
+            if (lms[j] != n) sa[buf[s[lms[j]]]++] = lms[j];
+        }
+        buf = sum_l;
+        sa[buf[s[n-1]]++] = n-1;
+        for (int_type i = 0;  i < n;  ++i) {
+            const int_type v = sa[i];
+            if (v >= 1  &&  !ls[v-1]) sa[buf[s[v-1]]++] = v-1;
+        }
+        buf = sum_l;
+        for (int_type i = n-1;  i >= 0;  --i) {
+            const int_type v = sa[i];
+            if (v >= 1  &&  ls[v-1]) sa[--buf[s[v-1]+1]] = v-1;
+        }
+    }
+
+    void operator()() {
+        sa.assign(n, 0);
+        if (n == 1) return;
+        if (n == 2) {
+            sa[0] = (s[0] < s[1]) ? 0 : 1;
+            sa[1] = 1 - sa[0];
+            return;
+        }
+
+        ls.assign(n, false);
+        for (int_type i = n-2;  i >= 0;  --i) ls[i] = (s[i] == s[i+1]) ? ls[i+1] : (s[i] < s[i+1]);
+
+        // bucket boundaries: sum_l[c] starts the L-type suffixes of symbol (c), sum_s[c] the S-type
+        sum_l.assign(upper+1, 0);
+        sum_s.assign(upper+1, 0);
+        for (int_type i = 0;  i < n;  ++i) {
+            if (!ls[i]) ++sum_s[s[i]];
+            else ++sum_l[s[i]+1];
+        }
+        for (int_type c = 0;  c <= upper;  ++c) {
+            sum_s[c] += sum_l[c];
+            if (c < upper) sum_l[c+1] += sum_s[c];
+        }
+
+        std::vector<int_type> lms_map(n+1, -1);
+        std::vector<int_type> lms;
+        for (int_type i = 1;  i < n;  ++i) {
+            if (!ls[i-1]  &&  ls[i]) {
+                lms_map[i] = lms.size();
+                lms.push_back(i);
+            }
+        }
+        const int_type m = lms.size();
+        induce(lms);
+        if (m == 0) return;
+
+        // name the LMS substrings in their induced order, and sort the LMS suffixes recursively
+        std::vector<int_type> sorted_lms;
+        sorted_lms.reserve(m);
+        for (int_type i = 0;  i < n;  ++i) if (lms_map[sa[i]] != -1) sorted_lms.push_back(sa[i]);
+        std::vector<int_type> rec_s(m);
+        int_type rec_upper = 0;
+        rec_s[lms_map[sorted_lms[0]]] = 0;
+        for (int_type i = 1;  i < m;  ++i) {
+            int_type l = sorted_lms[i-1];
+            int_type r = sorted_lms[i];
+            const int_type end_l = (lms_map[l]+1 < m) ? lms[lms_map[l]+1] : n;
+            const int_type end_r = (lms_map[r]+1 < m) ? lms[lms_map[r]+1] : n;
+            bool same = true;
+            if (end_l - l != end_r - r) {
+                same = false;
+            } else {
+                while (l < end_l  &&  s[l] == s[r]) { ++l;  ++r; }
+                if (l == n  ||  s[l] != s[r]) same = false;
+            }
+            if (!same) ++rec_upper;
+            rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+        }
+        std::vector<int_type> rec_sa;
+        suffix_array_is(rec_s, rec_upper, rec_sa)();
+        for (int_type i = 0;  i < m;  ++i) sorted_lms[i] = lms[rec_sa[i]];
+        induce(sorted_lms);
+    }
+};
+
+// Longest common extensions of a text, from its suffix array: the length of the common prefix of
+// suffixes (p) and (q) is the least LCP between their ranks.  The LCP array is computed as in:
+//     Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its Applications
+//     by T. Kasai, G. Lee, H. Arimura, S. Arikawa and K. Park
+// and range minima come from a sparse table over blocks of the LCP array, plus a scan inside the
+// blocks at either end, so a query takes constant time.
+struct lcp_table {
+    typedef boost::uint32_t index_type;
+    typedef std::ptrdiff_t diff_type;
+
+    static const diff_type block = 32;
+
+    diff_type n;
+    diff_type nb;
+    std::vector<index_type> rank;
+    std::vector<index_type> lcp;
+    // sparse[l*nb + b] is the least LCP over blocks [b, b + 2^l)
+    std::vector<index_type> sparse;
+    std::vector<unsigned char> log2;
+
+    lcp_table() : n(0), nb(0) {}
+
+    void clear() {
+        n = nb = 0;
+        std::vector<index_type>().swap(rank);
+        std::vector<index_type>().swap(lcp);
+        std::vector<index_type>().swap(sparse);
+        std::vector<unsigned char>().swap(log2);
+    }
+
+    // the symbols of (text) are less than (sigma)
+    void build(const std::vector<index_type>& text, const index_type& sigma) {
+        typedef suffix_array_is::int_type int_type;
+        n = text.size();
+        BOOST_ASSERT(n > 0);
+        std::vector<int_type> sa;
+        {
+            const std::vector<int_type> s(text.begin(), text.end());
+            suffix_array_is(s, sigma-1, sa)();
+        }
+        rank.resize(n);
+        for (diff_type r = 0;  r < n;  ++r) rank[sa[r]] = r;
+
+        // lcp[r] is the common prefix length of the suffixes ranked (r-1) and (r)
+        lcp.assign(n, 0);
+        for (diff_type i = 0, k = 0;  i < n;  ++i) {
+            if (rank[i] == 0) { k = 0;  continue; }
+            const diff_type j = sa[rank[i]-1];
+            while (i+k < n  &&  j+k < n  &&  text[i+k] == text[j+k]) ++k;
+            lcp[rank[i]] = k;
+            if (k > 0) --k;
+        }
+
+        nb = (n + block-1) / block;
+        log2.assign(nb+1, 0);
+        for (diff_type j = 2;  j <= nb;  ++j) log2[j] = log2[j/2] + 1;
+        const diff_type levels = log2[nb] + 1;
+        sparse.resize(levels * nb);
+        for (diff_type b = 0;  b < nb;  ++b) {
+            sparse[b] = *std::min_element(lcp.begin() + b*block, lcp.begin() + std::min(n, (b+1)*block));
+        }
+        for (diff_type l = 1;  l < levels;  ++l) {
+            const diff_type w = diff_type(1) << (l-1);
+            for (diff_type b = 0;  b + 2*w <= nb;  ++b) {
+                sparse[l*nb + b] = std::min(sparse[(l-1)*nb + b], sparse[(l-1)*nb + b + w]);
+            }
+        }
+    }
+
+    // least lcp[r], over (a <= r <= b)
+    diff_type range_min(const diff_type& a, const diff_type& b) const {
+        const diff_type ba = a / block;
+        const diff_type bb = b / block;
+        if (ba == bb) return *std::min_element(lcp.begin()+a, lcp.begin()+b+1);
+        diff_type m = std::min(*std::min_element(lcp.begin()+a, lcp.begin()+(ba+1)*block),
+                               *std::min_element(lcp.begin()+bb*block, lcp.begin()+b+1));
+        if (ba+1 < bb) {
+            const diff_type l = log2[bb-ba-1];
+            m = std::min(m, diff_type(std::min(sparse[l*nb + ba+1], sparse[l*nb + bb - (diff_type(1) << l)])));
+        }
+        return m;
+    }
+
+    // common prefix length of suffixes (p) and (q), for p != q
+    inline diff_type lce(const diff_type& p, const diff_type& q) const {
+        diff_type a = rank[p];
+        diff_type b = rank[q];
+        if (a > b) std::swap(a, b);
+        return range_min(a+1, b);
+    }
+};
+
+} // detail
+
+
+// An index over a pair of sequences that answers the length of any snake in constant time, from
+// the suffix array of the two sequences (seq1 # seq2), with longest-common-prefix range minima.
+// Passed with _snake_index, it replaces the element-by-element extension of snakes in the
+// random-access unit cost engines, which gives them their O(N + D^2) expected time even when long
+// runs of equal elements recur all over the edit graph (repetitive inputs).
+//
+// Building the index takes O(N) time, but with a constant that is worth hundreds of direct (let
+// alone vectorized) element comparisons per element, so it is built lazily: snakes are compared
+// directly until they have scanned a set multiple of the input length, and only then is the index
+// built.  It is kept between calls: queries against the same pair reuse it, after an O(N) check
+// that neither sequence has changed, and queries of a new seq2 against the same seq1 reuse the
+// ranking of seq1's elements.  Elements must be less-than comparable; the index is used with the
+// default element equality, and ignored otherwise, or if the sequences are not random access.
+// Positions in the index are of index_type, so a pair of sequences too long for them, 2^31 - 2
+// elements together, is never indexed, and its snakes are always compared directly.
+template <typename T>
+class lcp_index {
+public:
+    typedef detail::lcp_table::index_type index_type;
+    typedef std::ptrdiff_t diff_type;
+
+    // (build_after) sets the multiple of the input length compared directly before the index is
+    // built, where 0 builds it at the first long snake; by default it depends on whether the elements
+    // are compared with vector instructions
+    explicit lcp_index(const diff_type& build_after = -1)
+        : factor(build_after), len1(0), len2(0), current(false), scanned(0), forward_built(false), reverse_built(false) {}
+
+    // release all memory held by the index
+    void clear() {
+        std::vector<T>().swap(base1);
+        std::vector<T>().swap(base2);
+        std::vector<T>().swap(dict);
+        std::vector<index_type>().swap(text);
+        fwd.clear();
+        rev.clear();
+        len1 = len2 = 0;
+        current = forward_built = reverse_built = false;
+        scanned = 0;
+    }
+
+    // begin a query: the sequences it is given are checked against the index only once it is needed
+    void start() {
+        current = false;
+        scanned = 0;
+    }
+
+    // length of the equal run starting at seq1[j1], seq2[j2], up to (n)
+    template <typename Itr1, typename Itr2>
+    diff_type forward(const Itr1& seq1, const diff_type& n1, const Itr2& seq2, const diff_type& n2,
+                      const diff_type& j1, const diff_type& j2, const diff_type& n) {
+        if (!indexable(n1, n2)) return detail::snake_forward(seq1+j1, seq2+j2, n, detail::default_equal());
+        if (!current  &&  (forward_built || reverse_built)) sync(seq1, n1, seq2, n2);
+        if (!forward_built) {
+            if (scanned < budget<Itr1, Itr2>(n1, n2)) {
+                const diff_type s = detail::snake_forward(seq1+j1, seq2+j2, n, detail::default_equal());
+                scanned += s;
+                return s;
+            }
+            if (!current) sync(seq1, n1, seq2, n2);
+            fwd.build(text, dict.size() + 3);
+            forward_built = true;
+        }
+        return std::min(n, fwd.lce(j1, len1+1+j2));
+    }
+
+    // length of the equal run ending at seq1[j1-1], seq2[j2-1], up to (n)
+    template <typename Itr1, typename Itr2>
+    diff_type reverse(const Itr1& seq1, const diff_type& n1, const Itr2& seq2, const diff_type& n2,
+                      const diff_type& j1, const diff_type& j2, const diff_type& n) {
+        if (!indexable(n1, n2)) return detail::snake_reverse(seq1+j1, seq2+j2, n, detail::default_equal());
+        if (!current  &&  (forward_built || reverse_built)) sync(seq1, n1, seq2, n2);
+        if (!reverse_built) {
+            if (scanned < budget<Itr1, Itr2>(n1, n2)) {
+                const diff_type s = detail::snake_reverse(seq1+j1, seq2+j2, n, detail::default_equal());
+                scanned += s;
+                return s;
+            }
+            if (!current) sync(seq1, n1, seq2, n2);
+            std::vector<index_type> r(text.size());
+            std::reverse_copy(text.begin(), text.begin()+len1, r.begin());
+            r[len1] = text[len1];
+            std::reverse_copy(text.begin()+len1+1, text.begin()+len1+1+len2, r.begin()+len1+1);
+            r[len1+1+len2] = 0;
+            rev.build(r, dict.size() + 3);
+            reverse_built = true;
+        }
+        return std::min(n, rev.lce(len1-j1, len1+1+len2-j2));
+    }
+
+    // whether the text of seq1[0, n1) and seq2[0, n2), with its separator and end, fits the
+    // positions of the suffix array
+    static inline bool indexable(const diff_type& n1, const diff_type& n2) {
+        return n1 + n2 + 2 <= diff_type(0x7fffffff);
+    }
+
+private:
+    // direct comparisons allowed before the index is built, counted in elements: a multiple of the
+    // input length that roughly matches the cost of building, against that of comparing directly
+    template <typename Itr1, typename Itr2>
+    inline diff_type budget(const diff_type& n1, const diff_type& n2) const {
+        if (factor >= 0) return factor * (n1 + n2);
+        return (detail::is_vectorizable<Itr1, Itr2>::value ? 1024 : 32) * (n1 + n2);
+    }
+
+    // bring the index up to date with seq1[0, n1) and seq2[0, n2)
+    template <typename Itr1, typename Itr2>
+    void sync(const Itr1& seq1, const diff_type& n1, const Itr2& seq2, const diff_type& n2) {
+        BOOST_ASSERT(indexable(n1, n2));
+        current = true;
+        const bool same1 = diff_type(base1.size()) == n1  &&  std::equal(base1.begin(), base1.end(), seq1);
+        const bool same2 = diff_type(base2.size()) == n2  &&  std::equal(base2.begin(), base2.end(), seq2);
+        if (same1  &&  same2) return;
+        if (!same1) {
+            base1.assign(seq1, seq1+n1);
+            dict = base1;
+            std::sort(dict.begin(), dict.end());
+            dict.erase(std::unique(dict.begin(), dict.end()), dict.end());
+        }
+        if (!same2) base2.assign(seq2, seq2+n2);
+
+        // symbols: 0 ends the text, [1, |dict|] are the elements of seq1, then one symbol for all
+        // elements absent from seq1 (which never extend a snake), and a separator
+        const index_type absent = dict.size() + 1;
+        text.clear();
+        text.reserve(n1 + n2 + 2);
+        for (diff_type j = 0;  j < n1;  ++j) text.push_back(symbol(base1[j], absent));
+        text.push_back(absent + 1);
+        for (diff_type j = 0;  j < n2;  ++j) text.push_back(symbol(base2[j], absent));
+        text.push_back(0);
+        len1 = n1;
+        len2 = n2;
+        forward_built = reverse_built = false;
+    }
+
+    inline index_type symbol(const T& v, const index_type& absent) const {
+        const typename std::vector<T>::const_iterator f = std::lower_bound(dict.begin(), dict.end(), v);
+        return (f != dict.end()  &&  *f == v) ? index_type(1 + (f - dict.begin())) : absent;
+    }
+
+    const diff_type factor;
+    std::vector<T> base1;
+    std::vector<T> base2;
+    std::vector<T> dict;
+    std::vector<index_type> text;
+    diff_type len1;
+    diff_type len2;
+    // whether the index has been checked against the sequences of the current query
+    bool current;
+    // elements compared directly in the current query
+    diff_type scanned;
+    detail::lcp_table fwd;
+    detail::lcp_table rev;
+    bool forward_built;
+    bool reverse_built;
+};
+
+
+namespace detail {
+
+using boost::range_iterator;
+using std::random_access_iterator_tag;
+
+// default equality, carrying an lcp_index of seq1[0, len1) and seq2[0, len2)
+template <typename Itr1, typename Itr2, typename Index>
+struct lcp_equal {
+    Index* index;
+    Itr1 beg1;
+    std::ptrdiff_t len1;
+    Itr2 beg2;
+    std::ptrdiff_t len2;
+    lcp_equal(Index& index_, const Itr1& beg1_, const std::ptrdiff_t& len1_, const Itr2& beg2_, const std::ptrdiff_t& len2_)
+        : index(&index_), beg1(beg1_), len1(len1_), beg2(beg2_), len2(len2_) {}
+    template <typename T1, typename T2>
+    inline bool operator()(const T1& a, const T2& b) const { return a == b; }
+};
+
+template <typename Itr1, typename Itr2, typename Index>
+struct is_default_equal<lcp_equal<Itr1, Itr2, Index> > : public true_type {};
+
+template <typename Itr1, typename Itr2, typename Index>
+struct is_indexed_equal<lcp_equal<Itr1, Itr2, Index> > : public true_type {};
+
+// Snakes are answered by the index.  An index query costs a few cache misses, which is about what
+// a direct (vectorized) comparison of a few hundred elements costs, so runs are compared directly
+// up to that length, and only longer runs go to the index
+template <typename Itr1, typename Itr2, typename Index>
+struct snake<Itr1, Itr2, lcp_equal<Itr1, Itr2, Index>, void> {
+    typedef lcp_equal<Itr1, Itr2, Index> equal_type;
+    typedef snake<Itr1, Itr2, default_equal> direct;
+
+    static const std::ptrdiff_t direct_length = 256;
+
+    static inline std::ptrdiff_t forward(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const equal_type& equal) {
+        const std::ptrdiff_t s = direct::forward(S1, S2, std::min(n, direct_length), default_equal());
+        if (s < direct_length  ||  n <= direct_length) return s;
+        return equal.index->forward(equal.beg1, equal.len1, equal.beg2, equal.len2, S1 - equal.beg1, S2 - equal.beg2, n);
+    }
+
+    static inline std::ptrdiff_t reverse(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const equal_type& equal) {
+        const std::ptrdiff_t s = direct::reverse(S1, S2, std::min(n, direct_length), default_equal());
+        if (s < direct_length  ||  n <= direct_length) return s;
+        return equal.index->reverse(equal.beg1, equal.len1, equal.beg2, equal.len2, S1 - equal.beg1, S2 - equal.beg2, n);
+    }
+
+    template <typename Pos1, typename Pos2>
+    static inline void skip(Pos1& p1p, Pos1& p1, Pos2& p2p, Pos2& p2, const Itr1& end1, const Itr2& end2, const equal_type& equal) {
+        const std::ptrdiff_t s = forward(p1p.j, p2p.j, std::min(end1 - p1p.j, end2 - p2p.j) - 1, equal);
+        p1p.j += s;  p1.j += s;
+        p2p.j += s;  p2.j += s;
+    }
+
+    static inline void prefix(Itr1& j1, const Itr1& end1, Itr2& j2, const Itr2& end2, const equal_type& equal) {
+        const std::ptrdiff_t s = forward(j1, j2, std::min(end1 - j1, end2 - j2) - 1, equal);
+        j1 += s;
+        j2 += s;
+    }
+};
+
+template <typename Itr1, typename Itr2, typename Index>
+const std::ptrdiff_t snake<Itr1, Itr2, lcp_equal<Itr1, Itr2, Index>, void>::direct_length;
+
+// the equality handed to the engines: indexed when an lcp_index applies, otherwise as given
+template <typename Range1, typename Range2, typename Equal, typename Index, typename Enable = void>
+struct snake_index_equal {
+    typedef Equal type;
+    static inline const Equal& make(Range1 const&, Range2 const&, const Equal& equal, Index&) { return equal; }
+};
+
+template <typename Range1, typename Range2, typename T>
+struct snake_index_equal<Range1, Range2, default_equal, lcp_index<T>,
+                         typename enable_if<range_category<Range1, Range2, random_access_iterator_tag> >::type> {
+    typedef typename range_iterator<Range1 const>::type itr1_t;
+    typedef typename range_iterator<Range2 const>::type itr2_t;
+    typedef lcp_equal<itr1_t, itr2_t, lcp_index<T> > type;
+
+    static inline type make(Range1 const& seq1, Range2 const& seq2, const default_equal&, lcp_index<T>& index) {
+        index.start();
+        return type(index, boost::begin(seq1), boost::distance(seq1), boost::begin(seq2), boost::distance(seq2));
+    }
+};
+
+
+}}}}
+
+#endif
@@ -0,0 +1,149 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_MATERIALIZE_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_MATERIALIZE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/range/metafunctions.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_workspace.hpp>
+
+// The combined length of two sequences, one or both of them without random access, from which they
+// are copied into buffers for the unit cost engines to run on, and -1 to never copy them.  The copy
+// pays for itself at any length (the engine it avoids allocates per edit graph node), so by default
+// sequences are always copied
+#if !defined(BOOST_ALGORITHM_SEQUENCE_MATERIALIZE_LENGTH)
+#define BOOST_ALGORITHM_SEQUENCE_MATERIALIZE_LENGTH 0
+#endif
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+using boost::enable_if;
+using boost::is_same;
+using boost::is_arithmetic;
+using boost::is_reference;
+using boost::range_iterator;
+using boost::range_value;
+using boost::mpl::and_;
+using boost::mpl::or_;
+using boost::mpl::not_;
+using std::iterator_traits;
+using std::random_access_iterator_tag;
+
+// Sequences without random access keep the unit cost engines off their fast paths, so past a
+// threshold length they are copied into a buffer, and the engines run on that instead.
+// Random access sequences are passed through as they are.
+template <typename Range, typename Output, typename Enable = void>
+struct materialized {
+    typedef typename range_iterator<Range const>::type itr_t;
+    typedef boost::iterator_range<itr_t> range_type;
+    struct buffer_type { void clear() {} };
+
+    static inline range_type make(Range const& seq, buffer_type&) { return range_type(boost::begin(seq), boost::end(seq)); }
+};
+
+// Iterates over a buffer of element addresses, as the elements themselves.  Indexing yields a
+// reference too: the engines pass S[j] on to the script, where the iterator facade would copy
+template <typename T>
+class element_address_iterator
+    : public boost::iterator_adaptor<element_address_iterator<T>, const T* const*, T, boost::use_default, const T&> {
+public:
+    typedef boost::iterator_adaptor<element_address_iterator<T>, const T* const*, T, boost::use_default, const T&> adaptor_type;
+    typedef typename adaptor_type::difference_type difference_type;
+
+    element_address_iterator() {}
+    explicit element_address_iterator(const T* const* p) : adaptor_type(p) {}
+
+    inline const T& operator[](const difference_type& n) const { return *(this->base()[n]); }
+
+private:
+    friend class boost::iterator_core_access;
+    inline const T& dereference() const { return **(this->base()); }
+};
+
+// Elements are buffered by address, so an edit script reports the original elements
+template <typename Range, typename Output>
+struct materialized<Range, Output,
+                    typename enable_if<and_<not_<is_same<typename iterator_traits<typename range_iterator<Range const>::type>::iterator_category, random_access_iterator_tag> >,
+                                            is_reference<typename iterator_traits<typename range_iterator<Range const>::type>::reference>,
+                                            not_<and_<is_same<Output, none>, is_arithmetic<typename range_value<Range>::type> > > > >::type> {
+    typedef typename range_iterator<Range const>::type itr_t;
+    typedef typename range_value<Range>::type value_t;
+    typedef std::vector<const value_t*> buffer_type;
+    typedef element_address_iterator<value_t> iterator;
+    typedef boost::iterator_range<iterator> range_type;
+
+    static inline range_type make(Range const& seq, buffer_type& buf) {
+        for (itr_t j = boost::begin(seq);  j != boost::end(seq);  ++j) buf.push_back(&*j);
+        const value_t* const* b = buf.empty() ? 0 : &buf[0];
+        return range_type(iterator(b), iterator(b + buf.size()));
+    }
+};
+
+// Arithmetic elements are copied by value when only the distance is wanted, which also lets the
+// snakes compare them in bulk.  So are elements that the iterators yield only by value.
+template <typename Range, typename Output>
+struct materialized<Range, Output,
+                    typename enable_if<and_<not_<is_same<typename iterator_traits<typename range_iterator<Range const>::type>::iterator_category, random_access_iterator_tag> >,
+                                            or_<not_<is_reference<typename iterator_traits<typename range_iterator<Range const>::type>::reference> >,
+                                                and_<is_same<Output, none>, is_arithmetic<typename range_value<Range>::type> > > > >::type> {
+    typedef typename range_iterator<Range const>::type itr_t;
+    typedef typename range_value<Range>::type value_t;
+    typedef std::vector<value_t> buffer_type;
+    typedef boost::iterator_range<typename buffer_type::const_iterator> range_type;
+
+    static inline range_type make(Range const& seq, buffer_type& buf) {
+        for (itr_t j = boost::begin(seq);  j != boost::end(seq);  ++j) buf.push_back(*j);
+        return range_type(buf.begin(), buf.end());
+    }
+};
+
+// the buffers of a pair of sequences, as kept by a workspace between calls
+template <typename Buffer1, typename Buffer2>
+struct materialized_buffers {
+    Buffer1 buf1;
+    Buffer2 buf2;
+};
+
+template <typename Buffer1, typename Buffer2>
+inline void workspace_trim(materialized_buffers<Buffer1, Buffer2>& ws, const std::size_t& bytes) {
+    workspace_trim(ws.buf1, bytes);
+    workspace_trim(ws.buf2, bytes);
+}
+
+// whether seq1 and seq2 hold at least (n) elements between them, counting no further than that.
+// A negative (n) is never reached
+template <typename Range1, typename Range2>
+bool combined_length_reaches(Range1 const& seq1, Range2 const& seq2, const std::ptrdiff_t& n) {
+    if (n < 0) return false;
+    std::ptrdiff_t c = 0;
+    for (typename range_iterator<Range1 const>::type j = boost::begin(seq1);  c < n  &&  j != boost::end(seq1);  ++j) ++c;
+    for (typename range_iterator<Range2 const>::type j = boost::begin(seq2);  c < n  &&  j != boost::end(seq2);  ++j) ++c;
+    return c >= n;
+}
+
+
+}}}}
+
+#endif
@@ -0,0 +1,98 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_PARALLEL_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/detail/atomic_count.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_workspace.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// Items [0, n) scheduled in chunks of consecutive items.  Threads take the next chunk from a shared
+// counter as they finish the last, so the cost of an item, which can differ by orders of magnitude
+// from the next, never holds the others up for more than a chunk.  Each thread works in a workspace
+// of its own, and calls work(b, e, workspace) on the items [b, e) of each chunk it takes
+template <typename Work>
+class parallel_schedule : private boost::noncopyable {
+public:
+    parallel_schedule(Work& work_, const std::size_t& n_, const std::size_t& threads)
+        : work(work_), n(n_), chunk(std::max(std::size_t(1), std::min(std::size_t(256), n_ / (64*threads)))), next(0), failures(0) {}
+
+    // take chunks until none are left
+    void operator()() {
+        edit_distance_workspace workspace;
+        try {
+            while (long(failures) == 0) {
+                const std::size_t c = std::size_t(++next) - 1;
+                const std::size_t b = c*chunk;
+                if (b >= n) break;
+                work(b, std::min(b+chunk, n), workspace);
+            }
+        } catch (...) {
+            // the first failure keeps its exception, and stops the others at their next chunk
+            if (++failures == 1) error = boost::current_exception();
+        }
+    }
+
+    // once the threads are joined, which orders the write of (error) before it is read here
+    void rethrow() const {
+        if (long(failures) > 0) boost::rethrow_exception(error);
+    }
+
+private:
+    Work& work;
+    const std::size_t n;
+    const std::size_t chunk;
+    boost::detail::atomic_count next;
+    boost::detail::atomic_count failures;
+    boost::exception_ptr error;
+};
+
+template <typename Schedule>
+struct parallel_worker {
+    Schedule& schedule;
+    explicit parallel_worker(Schedule& schedule_) : schedule(schedule_) {}
+    void operator()() { schedule(); }
+};
+
+// runs the items [0, n) of (work) on a number of threads, by default one per hardware thread, and
+// rethrows the first exception any of them threw
+template <typename Work>
+void parallel_run(Work& work, const std::size_t& n, std::size_t threads) {
+    if (n == 0) return;
+    if (threads == 0) threads = std::max(1u, boost::thread::hardware_concurrency());
+    threads = std::min(threads, n);
+    parallel_schedule<Work> schedule(work, n, threads);
+    if (threads == 1) {
+        schedule();
+    } else {
+        boost::thread_group group;
+        for (std::size_t t = 0;  t < threads;  ++t) group.create_thread(parallel_worker<parallel_schedule<Work> >(schedule));
+        group.join_all();
+    }
+    schedule.rethrow();
+}
+
+}}}}
+
+#endif
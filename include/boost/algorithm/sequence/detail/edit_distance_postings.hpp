@@ -0,0 +1,89 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_POSTINGS_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_POSTINGS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/algorithm/sequence/detail/edit_distance_workspace.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+// The record numbers of a posting list, in increasing order, each stored as its difference from the
+// one before in a variable length code: seven bits to a byte, the high bit set on all but the last
+class posting_list {
+public:
+    posting_list() : last(0), n(0) {}
+
+    void push_back(const boost::uint32_t& r) {
+        boost::uint32_t d = (n == 0) ? r : r - last;
+        while (d >= 0x80) {
+            bytes.push_back(static_cast<unsigned char>(d | 0x80));
+            d >>= 7;
+        }
+        bytes.push_back(static_cast<unsigned char>(d));
+        last = r;
+        ++n;
+    }
+
+    std::size_t size() const { return n; }
+    std::size_t byte_size() const { return bytes.size(); }
+
+    // calls f(r) on each record number in turn
+    template <typename F>
+    void for_each(F& f) const {
+        boost::uint32_t r = 0;
+        std::size_t j = 0;
+        for (std::size_t k = 0;  k < n;  ++k) {
+            boost::uint32_t d = 0;
+            int shift = 0;
+            while (bytes[j] & 0x80) {
+                d |= boost::uint32_t(bytes[j++] & 0x7f) << shift;
+                shift += 7;
+            }
+            d |= boost::uint32_t(bytes[j++]) << shift;
+            r += d;
+            f(r);
+        }
+    }
+
+private:
+    std::vector<unsigned char> bytes;
+    boost::uint32_t last;
+    std::size_t n;
+};
+
+// the records found in the posting lists of a query, and how many of the lists each was found in
+struct posting_counts {
+    std::vector<boost::uint32_t> count;
+    std::vector<boost::uint32_t> touched;
+
+    inline void operator()(const boost::uint32_t& r) {
+        if (count[r]++ == 0) touched.push_back(r);
+    }
+};
+
+inline void workspace_trim(posting_counts& c, const std::size_t& bytes) {
+    workspace_trim(c.count, bytes);
+    workspace_trim(c.touched, bytes);
+}
+
+}}}}
+
+#endif
@@ -24,10 +24,234 @@ using boost::range_iterator;
 using boost::enable_if;
 using boost::is_same;
 using boost::mpl::and_;
+using boost::mpl::or_;
 using boost::mpl::not_;
 using std::random_access_iterator_tag;
 using boost::make_tuple;
 
+// The edit script of two sequences under any cost, in linear space, by Hirschberg's divide and
+// conquer.  The cheapest path crosses the middle row of the edit graph at the column where the
+// cheapest path to it from the start (a forward pass over the rows above) and from it to the end (a
+// reverse pass over the rows below) sum least, and the two halves either side of it are solved in
+// turn, until they are small enough for a direct table (of at most (cells) entries) and traceback.  A pass holds one row, so
+// space is O(m+n), and time about twice that of one pass over the whole graph.  The graph is that of
+// the search in edit_cost_struct: a run of equal elements is followed along its diagonal, save at
+// the last element of either sequence, so the two find scripts of the same cost
+template <typename Itr1, typename Itr2, typename Output, typename Cost, typename Equal, typename AllowSub, typename CostT>
+class linear_script {
+public:
+    linear_script(const Itr1& beg1, const Itr1& end1, const Itr2& beg2, const Itr2& end2, Output& output_,
+                  const Cost& cost_, const Equal& equal_, const sub_checker<AllowSub, Cost, CostT, Output>& allow_sub_,
+                  const std::size_t& cells = std::size_t(1) << 16)
+        : output(output_), cost(cost_), equal(equal_), allow_sub(allow_sub_), inf(std::numeric_limits<CostT>::max()), total(0), table_cells(cells) {
+        for (Itr1 j = beg1;  j != end1;  ++j) {
+            A.push_back(j);
+            D.push_back(cost.deletion(*j));
+        }
+        for (Itr2 j = beg2;  j != end2;  ++j) {
+            B.push_back(j);
+            I.push_back(cost.insertion(*j));
+        }
+        M = A.size();
+        N = B.size();
+    }
+
+    // outputs the script, and returns its cost
+    CostT operator()() {
+        solve(0, M, 0, N);
+        return total;
+    }
+
+private:
+    // edit path operations, as recorded during a traceback
+    enum { op_eql, op_sub, op_ins, op_del };
+
+    inline CostT add(const CostT& a, const CostT& b) const { return (a == inf  ||  b == inf) ? inf : a + b; }
+
+    inline bool eq(const std::size_t& i, const std::size_t& j) const { return i < M  &&  j < N  &&  equal(*A[i], *B[j]); }
+
+    // the graph leaves position (i,j), of equal elements (e), only along its diagonal
+    inline bool closed(const bool& e, const std::size_t& i, const std::size_t& j) const { return e  &&  i+1 < M  &&  j+1 < N; }
+
+    // the cost of the diagonal from position (i,j), of equal elements (e), or inf without substitution
+    inline CostT diagonal(const bool& e, const std::size_t& i, const std::size_t& j) const {
+        if (e) return 0;
+        return (allow_sub()) ? allow_sub.substitution(cost, *A[i], *B[j]) : inf;
+    }
+
+    // With F[j] the cheapest path from the start to (i,a2+j), and E[j] the equality there, takes the
+    // insertions along row (i)
+    void forward_insertions(const std::size_t& i, const std::size_t& a2, const std::size_t& c) {
+        E[0] = eq(i, a2);
+        for (std::size_t j = 1;  j <= c;  ++j) {
+            E[j] = eq(i, a2+j);
+            if (!closed(E[j-1], i, a2+j-1)) F[j] = std::min(F[j], add(F[j-1], I[a2+j-1]));
+        }
+    }
+
+    // moves F and E from row (i) to row (i+1)
+    void forward_row(const std::size_t& i, const std::size_t& a2, const std::size_t& c) {
+        CostT diag = F[0];
+        F[0] = closed(E[0], i, a2) ? inf : add(F[0], D[i]);
+        for (std::size_t j = 1;  j <= c;  ++j) {
+            CostT x = closed(E[j], i, a2+j) ? inf : add(F[j], D[i]);
+            x = std::min(x, add(diag, diagonal(E[j-1], i, a2+j-1)));
+            diag = F[j];
+            F[j] = x;
+        }
+        forward_insertions(i+1, a2, c);
+    }
+
+    // With G[j] the cheapest path from (i+1,a2+j) to the end, moves it to row (i)
+    void reverse_row(const std::size_t& i, const std::size_t& a2, const std::size_t& c) {
+        CostT below = G[c];
+        G[c] = closed(eq(i, a2+c), i, a2+c) ? inf : add(G[c], D[i]);
+        for (std::size_t j = c;  j-- > 0;  ) {
+            const bool e = eq(i, a2+j);
+            CostT x = add(below, diagonal(e, i, a2+j));
+            below = G[j];
+            if (!closed(e, i, a2+j)) x = std::min(x, std::min(add(G[j], D[i]), add(G[j+1], I[a2+j])));
+            G[j] = x;
+        }
+    }
+
+    void emit(const int& op, const std::size_t& i, const std::size_t& j) {
+        switch (op) {
+            case op_eql:
+                output.equality(*A[i], *B[j]);
+                break;
+            case op_sub: {
+                const CostT c = allow_sub.substitution(cost, *A[i], *B[j]);
+                allow_sub.substitution(output, *A[i], *B[j], c);
+                total += c;
+                break;
+            }
+            case op_ins:
+                output.insertion(*B[j], I[j]);
+                total += I[j];
+                break;
+            case op_del:
+                output.deletion(*A[i], D[i]);
+                total += D[i];
+                break;
+        }
+    }
+
+    // the script from (a1,a2) to (e1,e2), from a table of the whole
+    void direct(const std::size_t& a1, const std::size_t& e1, const std::size_t& a2, const std::size_t& e2) {
+        const std::size_t r = e1 - a1;
+        const std::size_t w = e2 - a2 + 1;
+        T.assign((r+1) * w, inf);
+        X.resize((r+1) * w);
+        for (std::size_t i = 0;  i <= r;  ++i) {
+            for (std::size_t j = 0;  j < w;  ++j) X[i*w + j] = eq(a1+i, a2+j);
+        }
+        T[0] = 0;
+        for (std::size_t i = 0;  i <= r;  ++i) {
+            for (std::size_t j = 0;  j < w;  ++j) {
+                const std::size_t t = i*w + j;
+                CostT x = T[t];
+                if (i > 0  &&  !closed(X[t-w], a1+i-1, a2+j)) x = std::min(x, add(T[t-w], D[a1+i-1]));
+                if (j > 0  &&  !closed(X[t-1], a1+i, a2+j-1)) x = std::min(x, add(T[t-1], I[a2+j-1]));
+                if (i > 0  &&  j > 0) x = std::min(x, add(T[t-w-1], diagonal(X[t-w-1], a1+i-1, a2+j-1)));
+                T[t] = x;
+            }
+        }
+
+        // trace back from the end, preferring the diagonal, then deletion
+        ops.clear();
+        std::size_t i = r;
+        std::size_t j = w - 1;
+        while (i > 0  ||  j > 0) {
+            const std::size_t t = i*w + j;
+            if (i > 0  &&  j > 0  &&  add(T[t-w-1], diagonal(X[t-w-1], a1+i-1, a2+j-1)) == T[t]) {
+                ops.push_back(char((X[t-w-1]) ? op_eql : op_sub));
+                --i;  --j;
+            } else if (i > 0  &&  !closed(X[t-w], a1+i-1, a2+j)  &&  add(T[t-w], D[a1+i-1]) == T[t]) {
+                ops.push_back(char(op_del));
+                --i;
+            } else {
+                ops.push_back(char(op_ins));
+                --j;
+            }
+        }
+        i = a1;
+        j = a2;
+        for (std::size_t k = ops.size();  k-- > 0;  ) {
+            emit(ops[k], i, j);
+            if (ops[k] != op_ins) ++i;
+            if (ops[k] != op_del) ++j;
+        }
+    }
+
+    void solve(std::size_t a1, const std::size_t& e1, std::size_t a2, const std::size_t& e2) {
+        // a run of equal elements is followed along its diagonal
+        for (;  a1 < e1  &&  a2 < e2  &&  closed(eq(a1, a2), a1, a2);  ++a1, ++a2) output.equality(*A[a1], *B[a2]);
+
+        const std::size_t r = e1 - a1;
+        const std::size_t c = e2 - a2;
+        if (r <= 1  ||  (r+1) * (c+1) <= table_cells) {
+            direct(a1, e1, a2, e2);
+            return;
+        }
+
+        const std::size_t mid = a1 + r/2;
+        F.assign(c+1, inf);
+        E.resize(c+1);
+        F[0] = 0;
+        forward_insertions(a1, a2, c);
+        for (std::size_t i = a1;  i < mid;  ++i) forward_row(i, a2, c);
+
+        G.assign(c+1, inf);
+        G[c] = 0;
+        for (std::size_t j = c;  j-- > 0;  ) {
+            if (!closed(eq(e1, a2+j), e1, a2+j)) G[j] = add(G[j+1], I[a2+j]);
+        }
+        for (std::size_t i = e1;  i-- > mid;  ) reverse_row(i, a2, c);
+
+        // the column the cheapest path crosses the middle row at
+        std::size_t k = 0;
+        CostT least = add(F[0], G[0]);
+        for (std::size_t j = 1;  j <= c;  ++j) {
+            const CostT x = add(F[j], G[j]);
+            if (x < least) {
+                least = x;
+                k = j;
+            }
+        }
+
+        solve(a1, mid, a2, a2+k);
+        solve(mid, e1, a2+k, e2);
+    }
+
+    Output& output;
+    const Cost cost;
+    const Equal equal;
+    const sub_checker<AllowSub, Cost, CostT, Output> allow_sub;
+    const CostT inf;
+    CostT total;
+    // largest table of a direct traceback
+    const std::size_t table_cells;
+
+    std::vector<Itr1> A;
+    std::vector<Itr2> B;
+    std::size_t M;
+    std::size_t N;
+    // deletion and insertion costs of each element
+    std::vector<CostT> D;
+    std::vector<CostT> I;
+
+    // rows of the forward and reverse passes
+    std::vector<CostT> F;
+    std::vector<char> E;
+    std::vector<CostT> G;
+
+    // table of a direct traceback, its equalities, and the operations it finds
+    std::vector<CostT> T;
+    std::vector<char> X;
+    std::vector<char> ops;
+};
+
 template <typename ForwardRange1, typename ForwardRange2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost, typename Enabled = void>
 struct edit_cost_struct {
 };
@@ -37,7 +261,8 @@ struct edit_cost_struct<ForwardRange1, ForwardRange2, Output, Cost, Equal, Allow
                         typename enable_if<and_<not_<is_same<Output, none> >,
                                                 not_<and_<range_category<ForwardRange1, ForwardRange2, random_access_iterator_tag>,
                                                           is_same<Cost, unit_cost>,
-                                                          is_same<AllowSub, boost::false_type> > > > >::type> {
+                                                          or_<is_same<AllowSub, boost::false_type>,
+                                                              is_same<AllowSub, boost::true_type> > > > > >::type> {
 
 typedef typename cost_type<Cost, typename boost::range_value<ForwardRange1>::type>::type cost_t;
 typedef typename range_iterator<ForwardRange1 const>::type itr1_t;
@@ -109,9 +334,16 @@ void traceback(head_t* path_head, const Equal& equal, sub_checker<AllowSub, Cost
     }
 }
 
-cost_t max_cost_fallback(max_cost_checker<MaxCost, cost_t, head_t>& max_cost_check, bool max_cost_exception, const itr1_t end1, const itr2_t end2, Output& output, const Cost& cost, const Equal& equal, sub_checker<AllowSub, Cost, cost_t, Output> const& allow_sub) {
+// output for an equal prefix that was trimmed ahead of the search
+void prefix_equalities(itr1_t j1, const itr1_t& pfx1, itr2_t j2, Output& output) {
+    for (;  j1 != pfx1;  ++j1,++j2) output.equality(*j1, *j2);
+}
+
+cost_t max_cost_fallback(max_cost_checker<MaxCost, cost_t, head_t>& max_cost_check, bool max_cost_exception, const itr1_t beg1, const itr1_t pfx1, const itr1_t end1, const itr2_t beg2, const itr2_t end2, Output& output, const Cost& cost, const Equal& equal, sub_checker<AllowSub, Cost, cost_t, Output> const& allow_sub) {
     if (max_cost_exception) throw max_edit_cost_exception();
 
+    prefix_equalities(beg1, pfx1, beg2, output);
+
     head_t* h;
     max_cost_check.get(h);
 
@@ -169,18 +401,28 @@ cost_t max_cost_fallback(max_cost_checker<MaxCost, cost_t, head_t>& max_cost_che
     return C;
 }
 
-cost_t operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allowsub, const MaxCost& max_cost, const bool max_cost_exception) {
+cost_t operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allowsub, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) {
     head_t* const hnull = static_cast<head_t*>(NULL);
 
     const itr1_t end1 = boost::end(seq1);
     const itr2_t end2 = boost::end(seq2);
-    pos1_t beg1;  beg1.beg(boost::begin(seq1));
-    pos2_t beg2;  beg2.beg(boost::begin(seq2));
 
-    // pool allocator for path nodes
-    boost::object_pool<head_t> pool;
+    // the search begins past any equal prefix
+    itr1_t pfx1 = boost::begin(seq1);
+    itr2_t pfx2 = boost::begin(seq2);
+    equal_prefix(pfx1, end1, pfx2, end2, equal);
+
+    pos1_t beg1;  beg1.beg(pfx1);
+    pos2_t beg2;  beg2.beg(pfx2);
+
+    // path nodes, and the visited nodes of the edit graph, kept by the workspace between calls
+    workspace_lease<sssp_workspace<head_t, visited_hash<pos1_t,pos2_t>, visited_equal> > ws(workspace);
+    ws->reset(visited_hash<pos1_t,pos2_t>(beg1,beg2));
+    node_arena<head_t>& pool = ws->pool;
+    visited_table<head_t, visited_hash<pos1_t,pos2_t>, visited_equal>& visited = ws->visited;
 
-    // priority queue for path nodes
+    // priority queue for path nodes: a skew heap settles ties between paths of equal cost
+    // in the order the edit scripts have always been chosen by
     boost::heap::skew_heap<head_t*, boost::heap::compare<heap_lessthan<pos1_t, pos2_t> > > heap(heap_lessthan<pos1_t, pos2_t>(beg1, beg2));
 
     sub_checker<AllowSub, Cost, cost_t, Output> allow_sub(allowsub);
@@ -189,20 +431,25 @@ cost_t operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, Output&
 
     head_t* path_head = hnull;
 
-    // keep track of nodes in the edit graph that have been visited
-    typedef boost::unordered_set<head_t*, visited_hash<pos1_t,pos2_t>, visited_equal> visited_t;
-    visited_t visited(31, visited_hash<pos1_t,pos2_t>(beg1,beg2));
+    // without a maximum cost, a search that grows past the workspace's limit of path nodes starts over
+    // in linear space.  Each node is a few dozen bytes, and a search between two long sequences far
+    // apart can expand nearly every position of their edit graph
+    const std::size_t node_limit = (is_same<MaxCost, none>::value) ? workspace.script_nodes() : std::size_t(-1);
 
     // kick off graph path frontier with initial node:
     heap.push(construct(pool, visited, beg1, beg2, cost_t(0), hnull));
 
     // update frontier from least-cost node at each iteration, until we hit sequence end
     while (true) {
+        if (pool.size() > node_limit) {
+            return linear_script<itr1_t, itr2_t, Output, Cost, Equal, AllowSub, cost_t>(boost::begin(seq1), end1, boost::begin(seq2), end2, output, cost, equal, allow_sub)();
+        }
+
         head_t* h = heap.top();
         heap.pop();
 
         if (max_cost_check(h->cost)) {
-            return max_cost_fallback(max_cost_check, max_cost_exception, end1, end2, output, cost, equal, allow_sub);
+            return max_cost_fallback(max_cost_check, max_cost_exception, boost::begin(seq1), pfx1, end1, boost::begin(seq2), end2, output, cost, equal, allow_sub);
         }
         max_cost_check.update(h);
 
@@ -227,6 +474,7 @@ cost_t operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, Output&
             pos1_t p1p = h->pos1;
             pos2_t p2 = h->pos2;  ++p2;
             pos2_t p2p = h->pos2;
+            snake<itr1_t, itr2_t, Equal>::skip(p1p, p1, p2p, p2, end1, end2, equal);
             while (true) {
                 const bool eq = equal(*p1p, *p2p);
                 if (!eq  ||  p1 == end1  ||  p2 == end2) {
@@ -248,6 +496,7 @@ cost_t operator()(ForwardRange1 const& seq1, ForwardRange2 const& seq2, Output&
 
     const cost_t edit_cost = path_head->cost;
 
+    prefix_equalities(boost::begin(seq1), pfx1, boost::begin(seq2), output);
     traceback(path_head, equal, allow_sub, output);
 
     return edit_cost;
@@ -267,41 +516,22 @@ typedef typename range_iterator<Range2 const>::type itr2_t;
 typedef std::vector<int>::difference_type diff_type;
 typedef size_t size_type;
 
-typedef std::vector<diff_type>::iterator itrv_t;
-
 typedef max_cost_checker_myers<MaxCost, diff_type, diff_type> max_cost_type;
 
 
-template <typename Vec, typename Itr> 
-inline void expand(Vec& V_data, Itr& Vf, Itr& Vr, size_type& R, const diff_type& D, const diff_type& delta) const {
-    size_type Rp = R + (R>>1);
-    V_data.resize(2 + 4*Rp);
-    Vf = V_data.begin() + R;
-    Vr = V_data.begin() + (3*R+1) - delta;
-
-    Itr Vp = V_data.begin() + (3*Rp+1) - delta;
-    for (diff_type j=D+delta;  j >= -D+delta;  --j) Vp[j] = Vr[j];
-    Vr = Vp;
-
-    Vp = V_data.begin() + Rp;
-    for (diff_type j=D;  j >= -D;  --j) Vp[j] = Vf[j];
-    Vf = Vp;
-
-    R = Rp;
-}
-
 std::string dump(const itr1_t& S1, const size_type& len1) const {
     std::string r;
     for (int j = 0; j < len1;  ++j) r += S1[j];
     return r;
 }
 
+template <typename T>
 diff_type max_cost_fallback(max_cost_checker_myers<MaxCost, diff_type, diff_type>& max_cost_check, const bool max_cost_exception, 
                             const Equal& equal, const MaxCost& max_cost, Output& output,
                             const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_type& len2,
                             const diff_type& eqb, const diff_type& eqe,
                             const itr1_t& S1, const size_type& L1, const itr2_t& S2, const size_type& L2,
-                            std::vector<diff_type>& V_data, const itrv_t& Vf, const itrv_t& Vr, const diff_type& delta, const diff_type& D) const {
+                            myers_diagonals<T>& V, const T* Vf, const T* Vr, const diff_type& delta, const diff_type& D) const {
     if (max_cost_exception) throw max_edit_cost_exception();
 
     for (diff_type k = -D;  k <= D;  k += 2) {
@@ -341,7 +571,7 @@ diff_type max_cost_fallback(max_cost_checker_myers<MaxCost, diff_type, diff_type
     // output equal prefix:
     for (diff_type j = 0;  j < eqb;  ++j) output.equality(seq1[j], seq2[j]);
     // output any known best-path in forward direction 
-    diff_type C = path(S1, r1b, S2, r2b, equal, max_cost, max_cost_exception, output, V_data);
+    diff_type C = path(S1, r1b, S2, r2b, equal, max_cost, max_cost_exception, output, V);
 
     // output the unknown subsequence: this is the part we bailed on due to hitting the maximum
     diff_type j1 = r1b;
@@ -375,21 +605,19 @@ diff_type max_cost_fallback(max_cost_checker_myers<MaxCost, diff_type, diff_type
     }
 
     // output known subsequence from reverse direction
-    C += path(S1+r1e, L1-r1e, S2+r2e, L2-r2e, equal, max_cost, max_cost_exception, output, V_data);
+    C += path(S1+r1e, L1-r1e, S2+r2e, L2-r2e, equal, max_cost, max_cost_exception, output, V);
     // equal suffix
     for (diff_type jj1=len1-eqe, jj2=len2-eqe; jj1 < len1; ++jj1,++jj2) output.equality(seq1[jj1], seq2[jj2]);
 
     return C;
 }
 
+template <typename T>
 typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
-path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_type& len2, const Equal& equal, const MaxCost& max_cost, const bool max_cost_exception, Output& output, std::vector<diff_type>& V_data) const {
+path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_type& len2, const Equal& equal, const MaxCost& max_cost, const bool max_cost_exception, Output& output, myers_diagonals<T>& V) const {
     // identify any equal suffix and/or prefix
-    diff_type eqb = 0;
-    for (;  eqb < std::min(len1, len2);  ++eqb) if (!equal(seq1[eqb],seq2[eqb])) break;
-    diff_type eqe = len1-1;
-    for (diff_type j2 = len2-1;  eqe > eqb && j2 > eqb;  --eqe,--j2) if (!equal(seq1[eqe],seq2[j2])) break;
-    eqe = len1-1-eqe;
+    diff_type eqb, eqe;
+    equal_affixes(seq1, len1, seq2, len2, equal, eqb, eqe);
 
     // sub-strings with equal suffix and/or prefix stripped
     const itr1_t S1 = seq1 + eqb;
@@ -416,10 +644,9 @@ path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_t
 
     // set up 'V' vectors for forward and reverse edit path diagonals
     // note, these are maintained to allow negative indexes
-    if (V_data.size() <= 0) V_data.resize(2*(1+2*10));
-    size_type R = V_data.size()/4;
-    std::vector<diff_type>::iterator Vf = V_data.begin()+R;
-    std::vector<diff_type>::iterator Vr = V_data.begin()+(3*R+1)-delta;
+    V.start(delta);
+    T*& Vf = V.Vf;
+    T*& Vr = V.Vr;
 
     // midpoint run of equal elements ("snake")
     diff_type r1b, r2b, r1e, r2e;
@@ -437,7 +664,7 @@ path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_t
             diff_type j2 = j1-k;
             r1b = j1;
             r2b = j2;
-            while (j1 < L1  &&  j2 < L2  &&  equal(S1[j1], S2[j2])) { ++j1;  ++j2; }
+            { const diff_type s = snake_forward(S1+j1, S2+j2, std::min(L1-j1, L2-j2), equal);  j1 += s;  j2 += s; }
 
             if (!delta_even  &&  (k-delta) >= -(D-1)  &&  (k-delta) <= (D-1)) {
                 diff_type r1 = Vr[k];
@@ -463,7 +690,7 @@ path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_t
             diff_type j2 = j1-k;
             r1e = j1;
             r2e = j2;
-            while (j1 > 0  &&  j2 > 0  &&  equal(S1[j1-1], S2[j2-1])) { --j1;  --j2; }
+            { const diff_type s = snake_reverse(S1+j1, S2+j2, std::min(j1, j2), equal);  j1 -= s;  j2 -= s; }
 
             if (delta_even  &&  k >= -D  &&  k <= D) {
                 diff_type f1 = Vf[k];   
@@ -489,22 +716,22 @@ path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_t
                                      seq1, len1, seq2, len2,
                                      eqb, eqe,
                                      S1, L1, S2, L2,
-                                     V_data, Vf, Vr, delta, D);
+                                     V, Vf, Vr, delta, D);
         }
 
         // expand the working vectors as needed
-        if (D >= R) expand(V_data, Vf, Vr, R, D, delta);
+        if (D >= V.R) V.expand(D, delta);
         ++D;
     }
 
     // output for equal prefix:
     for (diff_type j = 0;  j < eqb;  ++j) output.equality(seq1[j], seq2[j]);
     // output for path up to midpoint snake:
-    path(S1, r1b, S2, r2b, equal, max_cost, max_cost_exception, output, V_data);
+    path(S1, r1b, S2, r2b, equal, max_cost, max_cost_exception, output, V);
     // output for midpoint snake:
     for (diff_type j1=r1b,j2=r2b; j1 < r1e;  ++j1, ++j2) output.equality(S1[j1], S2[j2]);
     // output for path from midpoint to end:
-    path(S1+r1e, L1-r1e, S2+r2e, L2-r2e, equal, max_cost, max_cost_exception, output, V_data);
+    path(S1+r1e, L1-r1e, S2+r2e, L2-r2e, equal, max_cost, max_cost_exception, output, V);
     // output for equal suffix:
     for (diff_type j1=len1-eqe, j2=len2-eqe; j1 < len1; ++j1,++j2) output.equality(seq1[j1], seq2[j2]);
 
@@ -513,10 +740,214 @@ path(const itr1_t& seq1, const size_type& len1, const itr2_t& seq2, const size_t
 
 inline
 typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
-operator()(Range1 const& seq1, Range2 const& seq2, Output& output, const unit_cost&, const Equal& equal, const boost::false_type&, const MaxCost& max_cost, const bool max_cost_exception) const {
-    typedef std::vector<int>::difference_type diff_type;
-    std::vector<diff_type> V_data;
-    return path(boost::begin(seq1), distance(seq1), boost::begin(seq2), distance(seq2), equal, max_cost, max_cost_exception, output, V_data);
+operator()(Range1 const& seq1, Range2 const& seq2, Output& output, const unit_cost&, const Equal& equal, const boost::false_type&, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
+    const diff_type len1 = distance(seq1);
+    const diff_type len2 = distance(seq2);
+    // the diagonals are kept in the narrowest type that holds their positions
+    if (myers_fits<boost::int16_t>(len1, len2)) return script<boost::int16_t>(boost::begin(seq1), len1, boost::begin(seq2), len2, output, equal, max_cost, max_cost_exception, workspace);
+    if (myers_fits<boost::int32_t>(len1, len2)) return script<boost::int32_t>(boost::begin(seq1), len1, boost::begin(seq2), len2, output, equal, max_cost, max_cost_exception, workspace);
+    return script<diff_type>(boost::begin(seq1), len1, boost::begin(seq2), len2, output, equal, max_cost, max_cost_exception, workspace);
+}
+
+template <typename T>
+diff_type script(const itr1_t& seq1, const diff_type& len1, const itr2_t& seq2, const diff_type& len2, Output& output, const Equal& equal, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
+    workspace_lease<diagonal_workspace<edit_cost_struct, T> > ws(workspace);
+    myers_diagonals<T> V(ws->V);
+    return path(seq1, len1, seq2, len2, equal, max_cost, max_cost_exception, output, V);
+}
+
+}; // edit_cost_struct
+
+
+// If we are using unit cost for ins/del/sub, and our sequences support random-access, the script
+// can be recovered from the blocked bit-parallel engine, in place of a Dijkstra search over path nodes.
+// The distance is computed first, and bounds the diagonal band.  Problems small enough to keep the
+// vertical deltas of every column in that band are traced back from them directly; larger problems
+// are split at their middle column, using a forward pass and a reverse pass, as in:
+//     A Linear Space Algorithm for Computing Maximal Common Subsequences
+//     by D. S. Hirschberg, Communications of the ACM 18(6), 1975
+// Similar sequences are instead computed and split with furthest-reaching diagonals (see
+// diagonal_midpoint), in O(ND) time, dividing the problem much as the Myers path() does.
+template <typename Range1, typename Range2, typename Output, typename Equal, typename MaxCost>
+struct edit_cost_struct<Range1, Range2, Output, unit_cost, Equal, boost::true_type, MaxCost,
+                        typename enable_if<and_<not_<is_same<Output, none> >,
+                                                range_category<Range1, Range2, random_access_iterator_tag> > >::type> {
+
+typedef typename range_iterator<Range1 const>::type itr1_t;
+typedef typename range_iterator<Range2 const>::type itr2_t;
+typedef std::reverse_iterator<itr1_t> ritr1_t;
+typedef std::reverse_iterator<itr2_t> ritr2_t;
+
+typedef std::vector<int>::difference_type diff_type;
+
+typedef max_cost_checker_myers<MaxCost, diff_type, diff_type> max_cost_type;
+
+// largest number of (column, block) pairs kept for a direct traceback
+static const diff_type trace_blocks = diff_type(1) << 18;
+
+inline diff_type inf() const { return std::numeric_limits<diff_type>::max() / 4; }
+
+// edit path operations, as recorded during a traceback
+enum { op_eql, op_sub, op_ins, op_del };
+
+void traceback(const itr1_t& S1, const diff_type& L1, const itr2_t& S2, const diff_type& L2, const diff_type& D, const Equal& equal, Output& output) const {
+    const block_match_mask<itr1_t, itr2_t, Equal> peq(S1, L1, equal);
+    bitvec_blocks blocks;
+    bitvec_trace trace(L1, L2, bitparallel_band_blocks(L1, L2, D), inf());
+    bitparallel_banded_distance(L1, S2, L2, peq, blocks, D, trace);
+
+    // walk back from (L1,L2): any predecessor consistent with a cell's value is on a best path
+    std::vector<char> ops;
+    ops.reserve(L1+L2);
+    diff_type j1 = L1;
+    diff_type j2 = L2;
+    while (j1 > 0  ||  j2 > 0) {
+        const diff_type c = trace(j1, j2);
+        if (j1 > 0  &&  j2 > 0) {
+            const diff_type cd = trace(j1-1, j2-1);
+            if (cd == c  &&  equal(S1[j1-1], S2[j2-1])) {
+                ops.push_back(op_eql);  --j1;  --j2;
+                continue;
+            }
+            if (cd+1 == c) {
+                ops.push_back(op_sub);  --j1;  --j2;
+                continue;
+            }
+        }
+        if (j1 > 0  &&  trace(j1-1, j2)+1 == c) {
+            ops.push_back(op_del);  --j1;
+            continue;
+        }
+        BOOST_ASSERT(j2 > 0  &&  trace(j1, j2-1)+1 == c);
+        ops.push_back(op_ins);  --j2;
+    }
+
+    // replay the path from the beginning forward
+    for (std::vector<char>::reverse_iterator op(ops.rbegin());  op != ops.rend();  ++op) {
+        switch (*op) {
+            case op_eql: output.equality(S1[j1], S2[j2]);  ++j1;  ++j2;  break;
+            case op_sub: output.substitution(S1[j1], S2[j2], 1);  ++j1;  ++j2;  break;
+            case op_ins: output.insertion(S2[j2], 1);  ++j2;  break;
+            case op_del: output.deletion(S1[j1], 1);  ++j1;  break;
+        }
+    }
+}
+
+// output a best edit path of sequences with a known distance D
+void path(const itr1_t& seq1, const diff_type& len1, const itr2_t& seq2, const diff_type& len2, const diff_type& D, const Equal& equal, Output& output) const {
+    // identify any equal suffix and/or prefix
+    diff_type eqb, eqe;
+    equal_affixes(seq1, len1, seq2, len2, equal, eqb, eqe);
+
+    // sub-strings with equal suffix and/or prefix stripped
+    const itr1_t S1 = seq1 + eqb;
+    const diff_type L1 = len1-(eqb+eqe);
+    const itr2_t S2 = seq2 + eqb;
+    const diff_type L2 = len2-(eqb+eqe);
+
+    // output for equal prefix:
+    for (diff_type j = 0;  j < eqb;  ++j) output.equality(seq1[j], seq2[j]);
+
+    if (L1 <= 0) {
+        for (diff_type j = 0;  j < L2;  ++j) output.insertion(S2[j], 1);
+    } else if (L2 <= 0) {
+        for (diff_type j = 0;  j < L1;  ++j) output.deletion(S1[j], 1);
+    } else if (D >= 2  &&  diagonal_preferred(L1, L2, D)) {
+        // similar sequences divide at a midpoint of cost ceil(D/2), found from both ends in O(ND)
+        diff_type x1, x2;
+        diagonal_midpoint(S1, L1, S2, L2, D, equal, x1, x2);
+        path(S1, x1, S2, x2, (D+1)/2, equal, output);
+        path(S1+x1, L1-x1, S2+x2, L2-x2, D/2, equal, output);
+    } else if (L2 < 2  ||  L2*bitparallel_band_blocks(L1, L2, D) <= trace_blocks) {
+        traceback(S1, L1, S2, L2, D, equal, output);
+    } else {
+        // a best path crosses the middle column at some row (r) minimizing D(0,0 -> r,jm) + D(r,jm -> L1,L2)
+        const diff_type jm = L2/2;
+        std::vector<diff_type> F;
+        std::vector<diff_type> R;
+        bitvec_blocks blocks;
+        {
+            const block_match_mask<itr1_t, itr2_t, Equal> peq(S1, L1, equal);
+            bitvec_column_snapshot snapshot(L1, jm, inf(), F);
+            bitparallel_banded_distance(L1, S2, L2, peq, blocks, D, snapshot);
+        }
+        {
+            const ritr1_t R1(S1+L1);
+            const ritr2_t R2(S2+L2);
+            const block_match_mask<ritr1_t, ritr2_t, Equal> peq(R1, L1, equal);
+            bitvec_column_snapshot snapshot(L1, L2-jm, inf(), R);
+            bitparallel_banded_distance(L1, R2, L2, peq, blocks, D, snapshot);
+        }
+        diff_type r = 0;
+        for (diff_type j = 1;  j <= L1;  ++j) if (F[j] + R[L1-j] < F[r] + R[L1-r]) r = j;
+        BOOST_ASSERT(F[r] + R[L1-r] == D);
+
+        path(S1, r, S2, jm, F[r], equal, output);
+        path(S1+r, L1-r, S2+jm, L2-jm, R[L1-r], equal, output);
+    }
+
+    // output for equal suffix:
+    for (diff_type j1=len1-eqe, j2=len2-eqe; j1 < len1; ++j1,++j2) output.equality(seq1[j1], seq2[j2]);
+}
+
+typename cost_type<unit_cost, typename boost::range_value<Range1>::type>::type
+operator()(Range1 const& seq1_, Range2 const& seq2_, Output& output, const unit_cost&, const Equal& equal, const boost::true_type&, const MaxCost& max_cost, const bool max_cost_exception, edit_distance_workspace& workspace) const {
+    const itr1_t seq1 = boost::begin(seq1_);
+    const itr2_t seq2 = boost::begin(seq2_);
+    const diff_type len1 = distance(seq1_);
+    const diff_type len2 = distance(seq2_);
+
+    max_cost_type max_cost_check(max_cost);
+
+    // identify any equal suffix and/or prefix, once for both the distance and the path
+    diff_type eqb, eqe;
+    equal_affixes(seq1, len1, seq2, len2, equal, eqb, eqe);
+    const itr1_t S1 = seq1 + eqb;
+    const diff_type L1 = len1-(eqb+eqe);
+    const itr2_t S2 = seq2 + eqb;
+    const diff_type L2 = len2-(eqb+eqe);
+
+    // the distance, as in the distance-only engine: by furthest-reaching diagonals, or else
+    // with the bit-parallel band doubling
+    workspace_lease<diagonal_workspace<edit_cost_struct> > ws(workspace);
+    diff_type D = 0;
+    if (L1 <= 0  ||  L2 <= 0) {
+        D = std::max(L1, L2);
+    } else if ((D = diagonal_distance(S1, L1, S2, L2, equal, max_cost_check, ws->V)) < 0) {
+        const block_match_mask<itr1_t, itr2_t, Equal> peq(S1, L1, equal);
+        bitvec_blocks blocks;
+        const diff_type kmax = max_cost_check.cap(std::max(L1, L2));
+        diff_type k = std::min(kmax, std::abs(L2-L1) + bitvec_bits);
+        while (true) {
+            D = bitparallel_banded_distance(L1, S2, L2, peq, blocks, k);
+            if (D <= k  ||  k >= kmax) break;
+            k = std::min(kmax, 2*k);
+        }
+    }
+
+    if (max_cost_check(D)) {
+        if (max_cost_exception) throw max_edit_cost_exception();
+
+        // fast linear completion: a valid, but non-minimal, script
+        diff_type C = 0;
+        diff_type j = 0;
+        for (;  j < std::min(len1, len2);  ++j) {
+            if (equal(seq1[j], seq2[j])) {
+                output.equality(seq1[j], seq2[j]);
+            } else {
+                output.substitution(seq1[j], seq2[j], 1);
+                C += 1;
+            }
+        }
+        for (diff_type j1 = j;  j1 < len1;  ++j1) output.deletion(seq1[j1], 1);
+        for (diff_type j2 = j;  j2 < len2;  ++j2) output.insertion(seq2[j2], 1);
+        return C + std::abs(len2-len1);
+    }
+
+    for (diff_type j = 0;  j < eqb;  ++j) output.equality(seq1[j], seq2[j]);
+    path(S1, L1, S2, L2, D, equal, output);
+    for (diff_type j1=len1-eqe, j2=len2-eqe; j1 < len1; ++j1,++j2) output.equality(seq1[j1], seq2[j2]);
+    return D;
 }
 
 }; // edit_cost_struct
@@ -0,0 +1,223 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_SNAKE_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_SNAKE_HPP
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <boost/algorithm/sequence/detail/edit_distance_types.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+namespace detail {
+
+using boost::enable_if;
+using boost::is_same;
+using boost::is_integral;
+using boost::remove_cv;
+using boost::mpl::and_;
+using boost::mpl::or_;
+using boost::mpl::not_;
+using std::iterator_traits;
+
+// iterators known to address contiguous storage: pointers, and the iterators of std::vector
+// and std::basic_string (std::vector<bool> excepted).  Only integral elements are of interest
+template <typename Itr, typename V, bool Integral>
+struct is_contiguous_aux : public false_type {};
+
+template <typename Itr, typename V>
+struct is_contiguous_aux<Itr, V, true> : public
+    or_<is_same<Itr, typename std::vector<V>::iterator>,
+        is_same<Itr, typename std::vector<V>::const_iterator>,
+        is_same<Itr, typename std::basic_string<V>::iterator>,
+        is_same<Itr, typename std::basic_string<V>::const_iterator> > {};
+
+template <typename Itr>
+struct is_contiguous : public
+    is_contiguous_aux<Itr, typename iterator_traits<Itr>::value_type,
+                      is_integral<typename iterator_traits<Itr>::value_type>::value &&
+                      !is_same<typename iterator_traits<Itr>::value_type, bool>::value> {};
+
+template <typename T>
+struct is_contiguous<T*> : public true_type {};
+
+// number of leading equal bytes of a[0..n) and b[0..n)
+inline std::ptrdiff_t equal_bytes_forward(const unsigned char* a, const unsigned char* b, const std::ptrdiff_t& n) {
+    std::ptrdiff_t j = 0;
+#if defined(__GNUC__)
+#if defined(__SSE2__)
+    for (;  j+16 <= n;  j += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+j));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+j));
+        const unsigned int ne = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffu;
+        if (ne) return j + __builtin_ctz(ne);
+    }
+#endif
+#if BOOST_ENDIAN_LITTLE_BYTE
+    for (;  j+8 <= n;  j += 8) {
+        boost::uint64_t x, y;
+        std::memcpy(&x, a+j, 8);
+        std::memcpy(&y, b+j, 8);
+        if (x != y) return j + __builtin_ctzll(x ^ y)/8;
+    }
+#endif
+#endif
+    while (j < n  &&  a[j] == b[j]) ++j;
+    return j;
+}
+
+// number of trailing equal bytes of a[-n..0) and b[-n..0)
+inline std::ptrdiff_t equal_bytes_reverse(const unsigned char* a, const unsigned char* b, const std::ptrdiff_t& n) {
+    std::ptrdiff_t j = 0;
+#if defined(__GNUC__)
+#if defined(__SSE2__)
+    for (;  j+16 <= n;  j += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a-j-16));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b-j-16));
+        const unsigned int ne = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffu;
+        if (ne) return j + (__builtin_clz(ne) - 16);
+    }
+#endif
+#if BOOST_ENDIAN_LITTLE_BYTE
+    for (;  j+8 <= n;  j += 8) {
+        boost::uint64_t x, y;
+        std::memcpy(&x, a-j-8, 8);
+        std::memcpy(&y, b-j-8, 8);
+        if (x != y) return j + __builtin_clzll(x ^ y)/8;
+    }
+#endif
+#endif
+    while (j < n  &&  a[-1-j] == b[-1-j]) ++j;
+    return j;
+}
+
+// Runs of equal elements ("snakes"), given room for (n) elements on both sequences.
+// The general case compares one element at a time.
+template <typename Itr1, typename Itr2, typename Equal, typename Enable = void>
+struct snake {
+    // length of the equal run starting at S1[0], S2[0]
+    static inline std::ptrdiff_t forward(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal& equal) {
+        std::ptrdiff_t j = 0;
+        while (j < n  &&  equal(S1[j], S2[j])) ++j;
+        return j;
+    }
+
+    // length of the equal run ending at S1[-1], S2[-1]
+    static inline std::ptrdiff_t reverse(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal& equal) {
+        std::ptrdiff_t j = 0;
+        while (j < n  &&  equal(S1[-1-j], S2[-1-j])) ++j;
+        return j;
+    }
+
+    // advance Dijkstra expansion positions over an equal run: nothing to gain here
+    template <typename Pos1, typename Pos2>
+    static inline void skip(Pos1&, Pos1&, Pos2&, Pos2&, const Itr1&, const Itr2&, const Equal&) {}
+
+    // advance j1 and j2 over their equal prefix, stopping short of the last element of either sequence
+    static inline void prefix(Itr1& j1, const Itr1& end1, Itr2& j2, const Itr2& end2, const Equal& equal) {
+        if (j1 == end1  ||  j2 == end2) return;
+        Itr1 n1 = j1;  ++n1;
+        Itr2 n2 = j2;  ++n2;
+        while (n1 != end1  &&  n2 != end2  &&  equal(*j1, *j2)) {
+            j1 = n1;  ++n1;
+            j2 = n2;  ++n2;
+        }
+    }
+};
+
+// Integral elements in contiguous storage, under default equality, are equal exactly when their
+// bytes are: runs are found with SSE2 (or 8-byte words) mismatch search
+template <typename Itr1, typename Itr2>
+struct is_vectorizable : public
+    and_<is_contiguous<Itr1>,
+         is_contiguous<Itr2>,
+         is_integral<typename iterator_traits<Itr1>::value_type>,
+         is_same<typename remove_cv<typename iterator_traits<Itr1>::value_type>::type,
+                 typename remove_cv<typename iterator_traits<Itr2>::value_type>::type> > {};
+
+template <typename Itr1, typename Itr2, typename Equal>
+struct snake<Itr1, Itr2, Equal,
+             typename enable_if<and_<is_default_equal<Equal>,
+                                     not_<is_indexed_equal<Equal> >,
+                                     is_vectorizable<Itr1, Itr2> > >::type> {
+    typedef typename iterator_traits<Itr1>::value_type value_type;
+
+    static inline std::ptrdiff_t forward(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal&) {
+        if (n <= 0) return 0;
+        return equal_bytes_forward(reinterpret_cast<const unsigned char*>(&*S1),
+                                   reinterpret_cast<const unsigned char*>(&*S2), n*sizeof(value_type)) / sizeof(value_type);
+    }
+
+    static inline std::ptrdiff_t reverse(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal&) {
+        if (n <= 0) return 0;
+        return equal_bytes_reverse(reinterpret_cast<const unsigned char*>(&*(S1-1) + 1),
+                                   reinterpret_cast<const unsigned char*>(&*(S2-1) + 1), n*sizeof(value_type)) / sizeof(value_type);
+    }
+
+    // p1 and p2 lead p1p and p2p by one element, and must not pass the end of their sequence
+    template <typename Pos1, typename Pos2>
+    static inline void skip(Pos1& p1p, Pos1& p1, Pos2& p2p, Pos2& p2, const Itr1& end1, const Itr2& end2, const Equal& equal) {
+        const std::ptrdiff_t s = forward(p1p.j, p2p.j, std::min(end1 - p1p.j, end2 - p2p.j) - 1, equal);
+        p1p.j += s;  p1.j += s;
+        p2p.j += s;  p2.j += s;
+    }
+
+    static inline void prefix(Itr1& j1, const Itr1& end1, Itr2& j2, const Itr2& end2, const Equal& equal) {
+        const std::ptrdiff_t s = forward(j1, j2, std::min(end1 - j1, end2 - j2) - 1, equal);
+        j1 += s;
+        j2 += s;
+    }
+};
+
+template <typename Itr1, typename Itr2, typename Equal>
+inline std::ptrdiff_t snake_forward(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal& equal) {
+    return snake<Itr1, Itr2, Equal>::forward(S1, S2, n, equal);
+}
+
+template <typename Itr1, typename Itr2, typename Equal>
+inline std::ptrdiff_t snake_reverse(const Itr1& S1, const Itr2& S2, const std::ptrdiff_t& n, const Equal& equal) {
+    return snake<Itr1, Itr2, Equal>::reverse(S1, S2, n, equal);
+}
+
+// The affix trimming stage run ahead of every random-access engine: the lengths of the equal prefix,
+// and of the equal suffix of what remains.  Under unit costs, dropping them can't change the distance
+template <typename Itr1, typename Itr2, typename Equal>
+inline void equal_affixes(const Itr1& S1, const std::ptrdiff_t& L1, const Itr2& S2, const std::ptrdiff_t& L2, const Equal& equal, std::ptrdiff_t& eqb, std::ptrdiff_t& eqe) {
+    const std::ptrdiff_t L = std::min(L1, L2);
+    eqb = snake_forward(S1, S2, L, equal);
+    eqe = snake_reverse(S1+L1, S2+L2, L-eqb, equal);
+}
+
+// The Dijkstra engines take a general cost, where a common suffix may be better spent on (say) a
+// cheap substitution than on an expensive insertion, so only the prefix is trimmed.  It stops short of
+// the end of either sequence, just as the equal runs of a Dijkstra expansion do, so the search from the
+// trimmed prefix is the same one made from the beginning
+template <typename Itr1, typename Itr2, typename Equal>
+inline void equal_prefix(Itr1& j1, const Itr1& end1, Itr2& j2, const Itr2& end2, const Equal& equal) {
+    snake<Itr1, Itr2, Equal>::prefix(j1, end1, j2, end2, equal);
+}
+
+
+}}}}
+
+#endif
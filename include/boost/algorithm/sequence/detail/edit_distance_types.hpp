@@ -46,11 +46,11 @@ http://www.boost.org/LICENSE_1_0.txt
 #include <boost/concept/assert.hpp>
 #include <boost/concept/usage.hpp>
 
-#include <boost/unordered_set.hpp>
 #include <boost/functional/hash.hpp>
 
 #include <boost/parameter/name.hpp>
 #include <boost/parameter/preprocessor.hpp>
+#include <boost/parameter/aux_/tagged_argument.hpp>
 
 namespace boost {
 namespace algorithm {
@@ -88,6 +88,11 @@ namespace parameter {
     BOOST_PARAMETER_NAME(substitution)
     BOOST_PARAMETER_NAME(max_cost)
     BOOST_PARAMETER_NAME(max_cost_exception)
+    BOOST_PARAMETER_NAME(snake_index)
+    BOOST_PARAMETER_NAME(workspace)
+    BOOST_PARAMETER_NAME(filter_stats)
+    BOOST_PARAMETER_NAME(threads)
+    BOOST_PARAMETER_NAME(lsh)
 }
 
 
@@ -120,6 +125,25 @@ template <typename Range1, typename Range2, typename Tag> struct range_category
     and_<is_same<typename std::iterator_traits<typename boost::range_iterator<Range1>::type>::iterator_category, Tag>,
          is_same<typename std::iterator_traits<typename boost::range_iterator<Range2>::type>::iterator_category, Tag> > {};
 
+// std::abs() is ambiguous for unsigned arguments, which are perfectly sensible max-cost values
+template <typename T> inline T max_cost_abs(const T& x) { return (x < T(0)) ? T(0)-x : x; }
+
+// A max cost that is only tested against: once it is exceeded, the engines stop where they are and
+// report some cost past it, where a plain max cost has them complete a (non-minimal) edit path
+template <typename T>
+struct max_cost_bound {
+    T value;
+    explicit max_cost_bound(const T& value_) : value(value_) {}
+};
+
+template <typename T> inline T max_cost_abs(const max_cost_bound<T>& x) { return max_cost_abs(x.value); }
+
+template <typename MaxCost> struct is_max_cost_bound : public false_type {};
+template <typename T> struct is_max_cost_bound<max_cost_bound<T> > : public true_type {};
+
+template <typename MaxCost> struct has_max_cost : public
+    boost::mpl::or_<is_arithmetic<MaxCost>, is_max_cost_bound<MaxCost> > {};
+
 template <typename MaxCost, typename CostT, typename Node, typename Enable = void> struct max_cost_checker {};
 
 template <typename MaxCost, typename CostT, typename Node>
@@ -128,12 +152,14 @@ struct max_cost_checker<MaxCost, CostT, Node, typename enable_if<is_same<MaxCost
     typedef typename Node::pos2_type pos2_type;
     max_cost_checker(const MaxCost&, const pos1_type&, const pos2_type&) {}
     inline bool operator()(const CostT&) const { return false; }
+    inline bool bounded() const { return false; }
+    inline CostT past() const { return CostT(0); }
     inline void update(const Node*) const {}
     inline void get(Node*&) const {}
 };
 
 template <typename MaxCost, typename CostT, typename Node>
-struct max_cost_checker<MaxCost, CostT, Node, typename enable_if<is_arithmetic<MaxCost> >::type> {
+struct max_cost_checker<MaxCost, CostT, Node, typename enable_if<has_max_cost<MaxCost> >::type> {
     typedef typename Node::pos1_type pos1_type;
     typedef typename Node::pos2_type pos2_type;
     typedef typename pos1_type::difference_type diff_type;
@@ -145,8 +171,10 @@ struct max_cost_checker<MaxCost, CostT, Node, typename enable_if<is_arithmetic<M
     diff_type mctec;
     Node* mcnode;
 
-    max_cost_checker(const MaxCost& max_cost_, const pos1_type& pos1_, const pos2_type& pos2_) : max_cost(CostT(std::abs(max_cost_))), beg1(pos1_), beg2(pos2_), mcmin(-1), mctec(-1), mcnode(NULL) {}
+    max_cost_checker(const MaxCost& max_cost_, const pos1_type& pos1_, const pos2_type& pos2_) : max_cost(CostT(max_cost_abs(max_cost_))), beg1(pos1_), beg2(pos2_), mcmin(-1), mctec(-1), mcnode(NULL) {}
     inline bool operator()(const CostT& c) const { return c > max_cost; }
+    inline bool bounded() const { return is_max_cost_bound<MaxCost>::value; }
+    inline CostT past() const { return max_cost + CostT(1); }
     inline void update(Node* node) {
         // primary criteria:  position that consumes most sequence elements
         diff_type ttec = (node->pos1 - beg1) + (node->pos2 - beg2);
@@ -175,6 +203,9 @@ template <typename MaxCost, typename CostT, typename Pos>
 struct max_cost_checker_myers<MaxCost, CostT, Pos, typename enable_if<is_same<MaxCost, none> >::type> {
     max_cost_checker_myers(const MaxCost&) {}
     inline bool operator()(const CostT&) const { return false; }
+    inline bool bounded() const { return false; }
+    inline CostT past() const { return CostT(0); }
+    inline CostT cap(const CostT& c) const { return c; }
     inline void update(const Pos&, const Pos&, const CostT&) const {}
     inline void get(Pos&, Pos&, CostT&) const {}
     template <typename Itr>
@@ -183,15 +214,18 @@ struct max_cost_checker_myers<MaxCost, CostT, Pos, typename enable_if<is_same<Ma
 };
 
 template <typename MaxCost, typename CostT, typename Pos>
-struct max_cost_checker_myers<MaxCost, CostT, Pos, typename enable_if<is_arithmetic<MaxCost> >::type> {
+struct max_cost_checker_myers<MaxCost, CostT, Pos, typename enable_if<has_max_cost<MaxCost> >::type> {
     CostT max_cost;
     Pos mcmin;
     Pos mctec;
     Pos mck;
     remainder::kind kind;
 
-    max_cost_checker_myers(const MaxCost& max_cost_) : max_cost(CostT(std::abs(max_cost_))), mcmin(-1), mctec(-1), mck(0), kind(remainder::none) {}
+    max_cost_checker_myers(const MaxCost& max_cost_) : max_cost(CostT(max_cost_abs(max_cost_))), mcmin(-1), mctec(-1), mck(0), kind(remainder::none) {}
     inline bool operator()(const CostT& c) const { return c > max_cost; }
+    inline bool bounded() const { return is_max_cost_bound<MaxCost>::value; }
+    inline CostT past() const { return max_cost + CostT(1); }
+    inline CostT cap(const CostT& c) const { return std::min(c, max_cost); }
     template <typename Itr>
     inline void update(const Pos& k, const Itr& Vf, const Itr& Vr, const Pos& delta, const Pos& L1, const Pos& L2, const Pos& D) {
         Pos j1f = Vf[k];
@@ -258,6 +292,22 @@ struct default_equal {
     inline bool operator()(const T1& a, const T2& b) const { return a == b; }
 };
 
+// engines may swap the roles of seq1 and seq2.
+// swapping the arguments to 'equal' preserves its (seq1-element, seq2-element) signature
+template <typename Equal>
+struct swap_equal {
+    Equal equal;
+    swap_equal(const Equal& equal_) : equal(equal_) {}
+    template <typename T1, typename T2>
+    inline bool operator()(const T1& a, const T2& b) const { return equal(b, a); }
+};
+
+template <typename Equal> struct is_default_equal : public is_same<Equal, default_equal> {};
+template <typename Equal> struct is_default_equal<swap_equal<Equal> > : public is_default_equal<Equal> {};
+
+// equality that carries an index for extending snakes (see edit_distance_lcp.hpp)
+template <typename Equal> struct is_indexed_equal : public false_type {};
+
 
 template <typename AllowSub, typename Cost, typename CostT, typename Output, typename Enable=void>
 struct sub_checker {
@@ -354,14 +404,14 @@ construct(Pool& pool, Visited& visited, const Pos1& pos1_, const Pos2& pos2_, co
     head_t w;
     w.pos1 = pos1_;
     w.pos2 = pos2_;
-    typename Visited::iterator f(visited.find(&w));
-    if (visited.end() != f   &&   cost_ >= (*f)->cost) return static_cast<head_t*>(NULL);
+    std::size_t j;
+    const head_t* f = visited.find(&w, j);
+    if (f != NULL   &&   cost_ >= f->cost) return static_cast<head_t*>(NULL);
     head_t* r = pool.construct();
     r->pos1 = pos1_;
     r->pos2 = pos2_;
     r->cost = cost_;
-    if (visited.end() != f) visited.erase(f);
-    visited.insert(r);
+    visited.put(j, r);
     return r;
 }
 
@@ -373,15 +423,15 @@ construct(Pool& pool, Visited& visited, const Pos1& pos1_, const Pos2& pos2_, co
     head_t w;
     w.pos1 = pos1_;
     w.pos2 = pos2_;
-    typename Visited::iterator f(visited.find(&w));
-    if (visited.end() != f   &&   cost_ >= (*f)->cost) return static_cast<head_t*>(NULL);
+    std::size_t j;
+    const head_t* f = visited.find(&w, j);
+    if (f != NULL   &&   cost_ >= f->cost) return static_cast<head_t*>(NULL);
     head_t* r = pool.construct();
     r->pos1 = pos1_;
     r->pos2 = pos2_;
     r->cost = cost_;
     r->edge = edge_;
-    if (visited.end() != f) visited.erase(f);
-    visited.insert(r);
+    visited.put(j, r);
     return r;
 }
 
@@ -399,6 +449,7 @@ template <typename Pos1, typename Pos2>
 struct visited_hash {
     Pos1 beg1;
     Pos2 beg2;
+    visited_hash() {}
     visited_hash(const Pos1& pos1_, const Pos2& pos2_) : beg1(pos1_), beg2(pos2_) {}
     template<typename T> inline
     size_t operator()(T const* e) const {
@@ -453,6 +504,14 @@ struct cost_type<X, V, typename enable_if<has_type_cost_type<X> >::type> {
     typedef typename X::cost_type type;
 };
 
+template <typename X, typename V>
+struct cost_type<X, V, typename enable_if<boost::parameter::aux::is_tagged_argument<X> >::type> {
+    // a named argument can land in the positional 'cost' slot while the parameter library
+    // is computing result types for candidate overloads; supply a placeholder so that
+    // computation is well-formed, and let overload matching discard the candidate
+    typedef unit_cost::cost_type type;
+};
+
 
 template <typename X, typename Sequence, typename Enabled=void> struct TestCostSub {};
 
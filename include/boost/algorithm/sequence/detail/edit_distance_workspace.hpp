@@ -0,0 +1,433 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_WORKSPACE_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_DETAIL_EDIT_DISTANCE_WORKSPACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/detail/atomic_count.hpp>
+
+#if defined(BOOST_NO_CXX11_THREAD_LOCAL) && defined(BOOST_HAS_THREADS) && defined(BOOST_HAS_PTHREADS)
+#include <pthread.h>
+#endif
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+struct workspace_slot_base {
+    virtual ~workspace_slot_base() {}
+};
+
+template <typename T>
+struct workspace_slot : public workspace_slot_base {
+    T value;
+    bool busy;
+    workspace_slot() : busy(false) {}
+};
+
+inline std::size_t next_workspace_slot() {
+    static boost::detail::atomic_count n(0);
+    return static_cast<std::size_t>(++n) - 1;
+}
+
+// each type of state held by a workspace has a slot of its own
+template <typename T>
+inline std::size_t workspace_slot_id() {
+    static const std::size_t id = next_workspace_slot();
+    return id;
+}
+
+template <typename T> class workspace_lease;
+
+// Releases what a state holds past (bytes), at the end of a run.  States that hold no more than a
+// few tables of fixed size keep them
+template <typename T>
+inline void workspace_trim(T&, const std::size_t&) {}
+
+template <typename T>
+inline void workspace_trim(std::vector<T>& v, const std::size_t& bytes) {
+    if (v.capacity() * sizeof(T) > bytes) std::vector<T>().swap(v);
+}
+
+} // detail
+
+// Holds the working memory of the edit distance engines between calls: node pools, hash tables,
+// priority queues and diagonal arrays keep their capacity, so a loop over many pairs of sequences
+// allocates only as the largest of them requires.  One is passed with the _workspace parameter,
+// or else each thread uses a default workspace of its own.  A workspace may not be used by two
+// threads at once.  At the end of each call, the state of an engine past (keep) bytes is released:
+// a workspace passed explicitly keeps all of it by default, and a thread's default workspace keeps
+// 16 MB of each, so that one large call doesn't hold its memory for the life of the thread.
+// The search for an edit script under general costs, without a maximum cost, keeps at most
+// script_nodes() path nodes (2^21 by default) before it starts over in linear space.
+class edit_distance_workspace : private boost::noncopyable {
+public:
+    explicit edit_distance_workspace(const std::size_t& keep_ = std::size_t(-1)) : keep_bytes(keep_), nodes(std::size_t(1) << 21) {}
+    ~edit_distance_workspace() { clear(); }
+
+    // release the memory held, which is otherwise kept up to keep() bytes of each engine's state.
+    // Not to be called from inside a call using the workspace
+    void clear() {
+        for (std::size_t j = 0;  j < slots.size();  ++j) delete slots[j];
+        slots.clear();
+    }
+
+    std::size_t keep() const { return keep_bytes; }
+    void keep(const std::size_t& bytes) { keep_bytes = bytes; }
+
+    // -1 for no limit
+    std::size_t script_nodes() const { return nodes; }
+    void script_nodes(const std::size_t& n) { nodes = n; }
+
+private:
+    template <typename T> friend class detail::workspace_lease;
+
+    template <typename T>
+    detail::workspace_slot<T>& slot() {
+        const std::size_t id = detail::workspace_slot_id<T>();
+        if (id >= slots.size()) slots.resize(id+1, static_cast<detail::workspace_slot_base*>(NULL));
+        if (slots[id] == NULL) slots[id] = new detail::workspace_slot<T>();
+        return *static_cast<detail::workspace_slot<T>*>(slots[id]);
+    }
+
+    std::vector<detail::workspace_slot_base*> slots;
+    std::size_t keep_bytes;
+    std::size_t nodes;
+};
+
+namespace detail {
+
+// The state of type T held by a workspace, for the duration of one engine run.  Should the same
+// state be in use already (an edit distance computed inside a cost or equality function, say)
+// a temporary one stands in for it
+template <typename T>
+class workspace_lease : private boost::noncopyable {
+public:
+    explicit workspace_lease(edit_distance_workspace& workspace) : slot(workspace.slot<T>()), temp(NULL), keep(workspace.keep()) {
+        if (slot.busy) temp = new T();
+        else slot.busy = true;
+    }
+    ~workspace_lease() {
+        if (temp != NULL) {
+            delete temp;
+        } else {
+            if (keep != std::size_t(-1)) workspace_trim(slot.value, keep);
+            slot.busy = false;
+        }
+    }
+
+    inline T& operator*() const { return (temp != NULL) ? *temp : slot.value; }
+    inline T* operator->() const { return &**this; }
+
+private:
+    workspace_slot<T>& slot;
+    T* temp;
+    std::size_t keep;
+};
+
+// what a thread's default workspace keeps of each engine's state
+inline std::size_t thread_workspace_keep() { return std::size_t(1) << 24; }
+
+// The default workspace of the calling thread, created on first use, or NULL where there is no
+// thread local storage to keep it in
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+inline edit_distance_workspace* thread_workspace() {
+    static thread_local edit_distance_workspace workspace(thread_workspace_keep());
+    return &workspace;
+}
+#elif !defined(BOOST_HAS_THREADS)
+inline edit_distance_workspace* thread_workspace() {
+    static edit_distance_workspace workspace(thread_workspace_keep());
+    return &workspace;
+}
+#elif defined(BOOST_HAS_PTHREADS)
+template <typename T>
+struct thread_workspace_key {
+    static pthread_key_t key;
+    static pthread_once_t once;
+    static void destroy(void* w) { delete static_cast<T*>(w); }
+    static void create() { pthread_key_create(&key, &destroy); }
+    static T* get() {
+        pthread_once(&once, &create);
+        T* w = static_cast<T*>(pthread_getspecific(key));
+        if (w == NULL) {
+            w = new T(thread_workspace_keep());
+            pthread_setspecific(key, w);
+        }
+        return w;
+    }
+};
+
+template <typename T> pthread_key_t thread_workspace_key<T>::key;
+template <typename T> pthread_once_t thread_workspace_key<T>::once = PTHREAD_ONCE_INIT;
+
+inline edit_distance_workspace* thread_workspace() {
+    return thread_workspace_key<edit_distance_workspace>::get();
+}
+#else
+inline edit_distance_workspace* thread_workspace() {
+    return NULL;
+}
+#endif
+
+// The workspace of a call given none: the default workspace of the thread, or where there is no
+// thread local storage, one of its own for as long as it lives
+class default_workspace : private boost::noncopyable {
+public:
+    default_workspace() : workspace(thread_workspace()) {}
+
+    inline edit_distance_workspace& get() { return (workspace != NULL) ? *workspace : local; }
+
+private:
+    edit_distance_workspace* const workspace;
+    edit_distance_workspace local;
+};
+
+} // detail
+
+// Releases the memory held by the calling thread's default workspace.  Not to be called from inside
+// an edit distance call on the same thread
+inline void clear_thread_workspace() {
+    edit_distance_workspace* const workspace = detail::thread_workspace();
+    if (workspace != NULL) workspace->clear();
+}
+
+namespace detail {
+
+// Allocates nodes in blocks that are kept across reset(), to be handed out again
+template <typename T>
+class node_arena : private boost::noncopyable {
+public:
+    node_arena() : block(0), used(0), count(0) {}
+    ~node_arena() {
+        for (std::size_t j = 0;  j < blocks.size();  ++j) delete[] blocks[j];
+    }
+
+    inline T* construct() {
+        if (block < blocks.size()  &&  used >= block_size(block)) {
+            ++block;
+            used = 0;
+        }
+        if (block >= blocks.size()) blocks.push_back(new T[block_size(block)]);
+        ++count;
+        return blocks[block] + (used++);
+    }
+
+    void reset() {
+        block = 0;
+        used = 0;
+        count = 0;
+    }
+
+    // the nodes constructed since the last reset
+    inline std::size_t size() const { return count; }
+
+    // releases the blocks past those that fit in (bytes), and resets
+    void trim(const std::size_t& bytes) {
+        std::size_t j = 0;
+        for (std::size_t total = 0;  j < blocks.size();  ++j) {
+            total += block_size(j) * sizeof(T);
+            if (total > bytes) break;
+        }
+        for (std::size_t k = j;  k < blocks.size();  ++k) delete[] blocks[k];
+        blocks.resize(j);
+        reset();
+    }
+
+private:
+    // block (j) holds 64 * 2^j nodes, up to 2^20
+    static inline std::size_t block_size(const std::size_t& j) { return std::size_t(64) << std::min(j, std::size_t(14)); }
+
+    std::vector<T*> blocks;
+    std::size_t block;
+    std::size_t used;
+    std::size_t count;
+};
+
+// The nodes visited by a Dijkstra search, keyed by their position in the edit graph, in an open
+// addressing hash table.  Entries are stamped with the generation they were written in, so that
+// reset() empties the table without touching it
+template <typename T, typename Hash, typename Equal>
+class visited_table {
+public:
+    visited_table() : gen(0), count(0) {}
+
+    void reset(const Hash& hash_) {
+        hash = hash_;
+        ++gen;
+        count = 0;
+        if (table.empty()) table.resize(64);
+    }
+
+    // the node at the position of (key), or NULL, with the index to put() its replacement at
+    inline T* find(const T* key, std::size_t& j) const {
+        const std::size_t mask = table.size()-1;
+        for (j = hash(key) & mask;  table[j].gen == gen;  j = (j+1) & mask) {
+            if (equal(table[j].node, key)) return table[j].node;
+        }
+        return static_cast<T*>(NULL);
+    }
+
+    inline void put(std::size_t j, T* node) {
+        if (table[j].gen != gen) {
+            if (2*(count+1) > table.size()) {
+                grow();
+                find(node, j);
+            }
+            table[j].gen = gen;
+            ++count;
+        }
+        table[j].node = node;
+    }
+
+    // releases the table if it takes more than (bytes)
+    void trim(const std::size_t& bytes) {
+        if (table.capacity() * sizeof(entry) > bytes) std::vector<entry>().swap(table);
+    }
+
+private:
+    struct entry {
+        T* node;
+        std::size_t gen;
+        entry() : node(NULL), gen(0) {}
+    };
+
+    void grow() {
+        std::vector<entry> t(2*table.size());
+        t.swap(table);
+        const std::size_t mask = table.size()-1;
+        for (std::size_t k = 0;  k < t.size();  ++k) {
+            if (t[k].gen != gen) continue;
+            std::size_t j = hash(t[k].node) & mask;
+            while (table[j].gen == gen) j = (j+1) & mask;
+            table[j] = t[k];
+        }
+    }
+
+    std::vector<entry> table;
+    std::size_t gen;
+    std::size_t count;
+    Hash hash;
+    Equal equal;
+};
+
+// working memory of the Dijkstra engines
+template <typename Head, typename Hash, typename Equal>
+struct sssp_workspace {
+    node_arena<Head> pool;
+    visited_table<Head, Hash, Equal> visited;
+    std::vector<Head*> heap;
+
+    void reset(const Hash& hash) {
+        pool.reset();
+        visited.reset(hash);
+        heap.clear();
+    }
+};
+
+template <typename Head, typename Hash, typename Equal>
+inline void workspace_trim(sssp_workspace<Head, Hash, Equal>& ws, const std::size_t& bytes) {
+    ws.pool.trim(bytes);
+    ws.visited.trim(bytes);
+    workspace_trim(ws.heap, bytes);
+}
+
+template <typename T, typename Order>
+inline void heap_push(std::vector<T>& heap, const T& t, const Order& order) {
+    heap.push_back(t);
+    std::push_heap(heap.begin(), heap.end(), order);
+}
+
+// working memory of the diagonal engines
+template <typename Engine, typename T = std::ptrdiff_t>
+struct diagonal_workspace {
+    std::vector<T> V;
+};
+
+template <typename Engine, typename T>
+inline void workspace_trim(diagonal_workspace<Engine, T>& ws, const std::size_t& bytes) {
+    workspace_trim(ws.V, bytes);
+}
+
+// The diagonals of a Myers search, forward ones at Vf[-R..R] and reverse ones at Vr[delta-R..delta+R].
+// They hold positions in the first sequence, in a type (T) chosen to fit them (see myers_fits).
+// Searches to a depth of 16 keep them in a buffer of their own; deeper ones move them to (heap),
+// which grows by half again as needed
+template <typename T>
+class myers_diagonals : private boost::noncopyable {
+public:
+    typedef T value_type;
+
+    T* Vf;
+    T* Vr;
+    std::ptrdiff_t R;
+
+    explicit myers_diagonals(std::vector<T>& heap_) : Vf(NULL), Vr(NULL), R(local_radius), heap(heap_), data(local) {
+        std::fill(local, local + (2 + 4*local_radius), T(0));
+    }
+
+    // position the diagonals for a search of sequences whose lengths differ by (delta)
+    inline void start(const std::ptrdiff_t& delta) {
+        Vf = data + R;
+        Vr = data + (3*R+1) - delta;
+    }
+
+    // make room past round (D), keeping its diagonals
+    void expand(const std::ptrdiff_t& D, const std::ptrdiff_t& delta) {
+        const std::ptrdiff_t Rp = R + (R>>1);
+        if (data == local) {
+            heap.assign(2 + 4*Rp, T(0));
+            data = &heap[0];
+        } else {
+            heap.resize(2 + 4*Rp);
+            data = &heap[0];
+            start(delta);
+        }
+        // the new positions lie above the old ones, so copying down is safe in place
+        T* Vp = data + (3*Rp+1) - delta;
+        for (std::ptrdiff_t j = D+delta;  j >= -D+delta;  --j) Vp[j] = Vr[j];
+        Vr = Vp;
+        Vp = data + Rp;
+        for (std::ptrdiff_t j = D;  j >= -D;  --j) Vp[j] = Vf[j];
+        Vf = Vp;
+        R = Rp;
+    }
+
+private:
+    enum { local_radius = 16 };
+
+    std::vector<T>& heap;
+    T* data;
+    T local[2 + 4*local_radius];
+};
+
+// Positions of a Myers search over lengths (L1, L2) stray past either end by at most the depth of
+// the search, so a type holds them when it holds 2*(L1+L2)
+template <typename T>
+inline bool myers_fits(const std::ptrdiff_t& L1, const std::ptrdiff_t& L2) {
+    return (L1+L2) <= std::ptrdiff_t(boost::integer_traits<T>::const_max / 2);
+}
+
+} // detail
+
+}}}
+
+#endif
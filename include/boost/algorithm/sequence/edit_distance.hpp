@@ -14,9 +14,23 @@ http://www.boost.org/LICENSE_1_0.txt
 #if !defined(BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_HPP)
 #define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_HPP
 
+#include <boost/algorithm/sequence/detail/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_batch.hpp>
+
 #include <boost/concept/requires.hpp>
+#include <boost/parameter/config.hpp>
+#include <boost/parameter/parameters.hpp>
+#include <boost/parameter/value_type.hpp>
+#include <boost/preprocessor/repetition/enum_binary_params.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/repeat_from_to.hpp>
+#include <boost/preprocessor/facilities/intercept.hpp>
+#include <boost/preprocessor/cat.hpp>
 
-#include <boost/algorithm/sequence/detail/edit_distance.hpp>
+// The parameter specifications below hold at most 8 parameters, the default arity of Boost.Parameter
+#if BOOST_PARAMETER_MAX_ARITY < 8
+#error "edit_distance requires BOOST_PARAMETER_MAX_ARITY of at least 8"
+#endif
 
 namespace boost {
 namespace algorithm {
@@ -36,38 +50,319 @@ using detail::nonconst_default;
 using detail::default_equal;
 
 
-template <typename Sequence1, typename Sequence2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+template <typename Sequence1, typename Sequence2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost, typename Index>
 inline
 BOOST_CONCEPT_REQUIRES(
     ((ForwardRangeConvertible<Sequence1>))
     ((ForwardRangeConvertible<Sequence2>))
     ((SequenceAlignmentCost<Cost, Sequence1>)),
 (typename cost_type<Cost, typename range_value<Sequence1>::type>::type))
-edit_distance_check(Sequence1 const& seq1, Sequence2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception) {
-    return edit_cost_impl(as_literal(seq1), as_literal(seq2), output, cost, equal, allow_sub, max_cost, max_cost_exception);
-}
-
-
-BOOST_PARAMETER_FUNCTION(
-(typename cost_type<typename value_type<Args, parameter::tag::cost, unit_cost>::type,
-                    typename range_value<typename value_type<Args, parameter::tag::sequence1>::type>::type>::type),
-    edit_distance,
-    parameter::tag,
-    (required
-        (sequence1, *)
-        (sequence2, *))
-    (optional
-        (cost, *, unit_cost())
-        (equal, *, default_equal())
-        (in_out(script), *, nonconst_default<none>())
-        (substitution, *, false_type())
-        (max_cost, *, none())
-        (max_cost_exception, (bool), false))
-)
-{
-    return edit_distance_check(sequence1, sequence2, script, cost, equal, substitution, max_cost, max_cost_exception);
+edit_distance_check(Sequence1 const& seq1, Sequence2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, edit_distance_workspace& workspace) {
+    return edit_cost_impl(as_literal(seq1), as_literal(seq2), output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace);
+}
+
+// with no workspace given, the default workspace of this thread is used
+template <typename Sequence1, typename Sequence2, typename Output, typename Cost, typename Equal, typename AllowSub, typename MaxCost, typename Index>
+inline
+typename cost_type<Cost, typename range_value<Sequence1>::type>::type
+edit_distance_check(Sequence1 const& seq1, Sequence2 const& seq2, Output& output, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const bool max_cost_exception, Index& index, none&) {
+    detail::default_workspace workspace;
+    return edit_distance_check(seq1, seq2, output, cost, equal, allow_sub, max_cost, max_cost_exception, index, workspace.get());
+}
+
+
+namespace detail {
+
+// The parameters that may be passed by position.  Those added since, _snake_index and _workspace,
+// are only ever named, and are left out so that the specification stays within the default arity
+// of Boost.Parameter: named arguments of keywords it doesn't hold are passed through as they are
+typedef boost::parameter::parameters<
+    boost::parameter::required<parameter::tag::sequence1>,
+    boost::parameter::required<parameter::tag::sequence2>,
+    boost::parameter::optional<parameter::tag::cost>,
+    boost::parameter::optional<parameter::tag::equal>,
+    boost::parameter::optional<parameter::tag::script>,
+    boost::parameter::optional<parameter::tag::substitution>,
+    boost::parameter::optional<parameter::tag::max_cost>,
+    boost::parameter::optional<parameter::tag::max_cost_exception>
+> edit_distance_parameters;
+
+// The value of a parameter, looked up in the arguments (Args) bound by edit_distance_parameters,
+// then in up to two named arguments (A8, A9) passed past its arity, which override them
+template <typename Args, typename Tag, typename Default, typename A8 = none, typename A9 = none>
+struct edit_distance_value {
+    typedef typename value_type<A9, Tag, typename edit_distance_value<Args, Tag, Default, A8>::type>::type type;
+};
+
+template <typename Args, typename Tag, typename Default, typename A8>
+struct edit_distance_value<Args, Tag, Default, A8, none> {
+    typedef typename value_type<A8, Tag, typename value_type<Args, Tag, Default>::type>::type type;
+};
+
+template <typename Args, typename Tag, typename Default>
+struct edit_distance_value<Args, Tag, Default, none, none> {
+    typedef typename value_type<Args, Tag, Default>::type type;
+};
+
+template <typename Args, typename A8 = none, typename A9 = none>
+struct edit_distance_result {
+    typedef typename cost_type<typename edit_distance_value<Args, parameter::tag::cost, unit_cost, A8, A9>::type,
+                               typename range_value<typename edit_distance_value<Args, parameter::tag::sequence1, void, A8, A9>::type>::type>::type type;
+};
+
+template <typename Args>
+inline typename edit_distance_result<Args>::type
+edit_distance_args(const Args& args) {
+    return edit_distance_check(args[parameter::_sequence1],
+                               args[parameter::_sequence2],
+                               args[parameter::_script | nonconst_default<none>()],
+                               args[parameter::_cost | unit_cost()],
+                               args[parameter::_equal | default_equal()],
+                               args[parameter::_substitution | false_type()],
+                               args[parameter::_max_cost | none()],
+                               args[parameter::_max_cost_exception | false],
+                               args[parameter::_snake_index | nonconst_default<none>()],
+                               args[parameter::_workspace | nonconst_default<none>()]);
+}
+
+} // detail
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_OVERLOAD(z, n, unused) \
+template <BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(n, A, const BOOST_PP_INTERCEPT)>::type>::type \
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_args(detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(2, 9, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_OVERLOAD
+
+// A script handler passed by position (a4) is written to, so it binds as in/out: a non-const
+// argument there takes these overloads over the ones above
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_TYPE(z, n, unused) , BOOST_PP_CAT(A, n) const
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_ARG(z, n, unused) , BOOST_PP_CAT(A, n) const& BOOST_PP_CAT(a, n)
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_SCRIPT_OVERLOAD(z, n, unused) \
+template <BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(4, A, const BOOST_PP_INTERCEPT), A4 BOOST_PP_REPEAT_FROM_TO(5, n, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_TYPE, ~)>::type>::type \
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(4, A, const& a), A4& a4 BOOST_PP_REPEAT_FROM_TO(5, n, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_ARG, ~)) { \
+    return detail::edit_distance_args(detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(5, 9, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_SCRIPT_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_SCRIPT_OVERLOAD
+
+// arguments past the arity of edit_distance_parameters, which are named, are added to the arguments it binds
+template <BOOST_PP_ENUM_PARAMS(9, typename A)>
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(8, A, const BOOST_PP_INTERCEPT)>::type, A8 const>::type
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(9, A, const& a)) {
+    return detail::edit_distance_args((detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(8, a)), a8));
+}
+
+template <BOOST_PP_ENUM_PARAMS(10, typename A)>
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(8, A, const BOOST_PP_INTERCEPT)>::type, A8 const, A9 const>::type
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(10, A, const& a)) {
+    return detail::edit_distance_args((detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(8, a)), a8, a9));
+}
+
+template <BOOST_PP_ENUM_PARAMS(9, typename A)>
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(4, A, const BOOST_PP_INTERCEPT), A4 BOOST_PP_REPEAT_FROM_TO(5, 8, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_TYPE, ~)>::type, A8 const>::type
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(4, A, const& a), A4& a4 BOOST_PP_REPEAT_FROM_TO(5, 9, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_ARG, ~)) {
+    return detail::edit_distance_args((detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(8, a)), a8));
 }
 
+template <BOOST_PP_ENUM_PARAMS(10, typename A)>
+inline typename detail::edit_distance_result<typename detail::edit_distance_parameters::bind<BOOST_PP_ENUM_BINARY_PARAMS(4, A, const BOOST_PP_INTERCEPT), A4 BOOST_PP_REPEAT_FROM_TO(5, 8, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_TYPE, ~)>::type, A8 const, A9 const>::type
+edit_distance(BOOST_PP_ENUM_BINARY_PARAMS(4, A, const& a), A4& a4 BOOST_PP_REPEAT_FROM_TO(5, 10, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_ARG, ~)) {
+    return detail::edit_distance_args((detail::edit_distance_parameters()(BOOST_PP_ENUM_PARAMS(8, a)), a8, a9));
+}
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_TYPE
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CONST_ARG
+
+
+template <typename Sequence1, typename Sequence2, typename MaxCost, typename Cost, typename Equal, typename AllowSub, typename Index, typename Stats>
+inline bool
+edit_distance_within_check(Sequence1 const& seq1, Sequence2 const& seq2, const MaxCost& max_cost, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, Index& index, edit_distance_workspace& workspace, Stats& stats) {
+    typedef typename cost_type<Cost, typename range_value<Sequence1>::type>::type cost_t;
+    typedef detail::lower_bound_filter<Cost, Equal> filter;
+    if (!filter::within(as_literal(seq1), as_literal(seq2), allow_sub, max_cost, workspace, stats)) return false;
+    return edit_distance_check(seq1, seq2, nonconst_default<none>(), cost, equal, allow_sub, detail::max_cost_bound<MaxCost>(max_cost), false, index, workspace) <= cost_t(detail::max_cost_abs(max_cost));
+}
+
+template <typename Sequence1, typename Sequence2, typename MaxCost, typename Cost, typename Equal, typename AllowSub, typename Index, typename Stats>
+inline bool
+edit_distance_within_check(Sequence1 const& seq1, Sequence2 const& seq2, const MaxCost& max_cost, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, Index& index, none&, Stats& stats) {
+    detail::default_workspace workspace;
+    return edit_distance_within_check(seq1, seq2, max_cost, cost, equal, allow_sub, index, workspace.get(), stats);
+}
+
+
+namespace detail {
+
+// _snake_index, _workspace and _filter_stats are only ever named (see edit_distance_parameters)
+typedef boost::parameter::parameters<
+    boost::parameter::required<parameter::tag::sequence1>,
+    boost::parameter::required<parameter::tag::sequence2>,
+    boost::parameter::required<parameter::tag::max_cost>,
+    boost::parameter::optional<parameter::tag::cost>,
+    boost::parameter::optional<parameter::tag::equal>,
+    boost::parameter::optional<parameter::tag::substitution>
+> edit_distance_within_parameters;
+
+template <typename Args>
+inline bool
+edit_distance_within_args(const Args& args) {
+    return edit_distance_within_check(args[parameter::_sequence1],
+                                      args[parameter::_sequence2],
+                                      args[parameter::_max_cost],
+                                      args[parameter::_cost | unit_cost()],
+                                      args[parameter::_equal | default_equal()],
+                                      args[parameter::_substitution | false_type()],
+                                      args[parameter::_snake_index | nonconst_default<none>()],
+                                      args[parameter::_workspace | nonconst_default<none>()],
+                                      args[parameter::_filter_stats | nonconst_default<none>()]);
+}
+
+} // detail
+
+// Whether the edit distance of two sequences is at most a maximum, which is the third (positional or
+// _max_cost) parameter.  The other named parameters of edit_distance() apply, except for _script and
+// those concerned with a max cost.  Under unit costs, pairs are first put through cheap lower bounds
+// on the distance (see edit_distance_filter.hpp), and those they reject never reach an engine;
+// the counts of what each rejected are kept in an edit_distance_filter_stats passed with
+// _filter_stats.  Otherwise the engine stops as soon as its cost passes the maximum.
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_WITHIN_OVERLOAD(z, n, unused) \
+template <BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline bool \
+edit_distance_within(BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_within_args(detail::edit_distance_within_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(3, 9, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_WITHIN_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_WITHIN_OVERLOAD
+
+template <BOOST_PP_ENUM_PARAMS(9, typename A)>
+inline bool
+edit_distance_within(BOOST_PP_ENUM_BINARY_PARAMS(9, A, const& a)) {
+    return detail::edit_distance_within_args((detail::edit_distance_within_parameters()(BOOST_PP_ENUM_PARAMS(8, a)), a8));
+}
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+inline OutputIterator
+edit_distance_batch_check(Sequence const& query, Candidates const& candidates, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, edit_distance_workspace& workspace) {
+    return detail::edit_distance_batch_run(as_literal(query), candidates, results, cost, equal, allow_sub, max_cost, workspace);
+}
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+inline OutputIterator
+edit_distance_batch_check(Sequence const& query, Candidates const& candidates, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, none&) {
+    detail::default_workspace workspace;
+    return edit_distance_batch_check(query, candidates, results, cost, equal, allow_sub, max_cost, workspace.get());
+}
+
+
+namespace detail {
+
+typedef boost::parameter::parameters<
+    boost::parameter::optional<parameter::tag::cost>,
+    boost::parameter::optional<parameter::tag::equal>,
+    boost::parameter::optional<parameter::tag::substitution>,
+    boost::parameter::optional<parameter::tag::max_cost>,
+    boost::parameter::optional<parameter::tag::workspace>
+> edit_distance_batch_parameters;
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Args>
+inline OutputIterator
+edit_distance_batch_args(Sequence const& query, Candidates const& candidates, OutputIterator results, const Args& args) {
+    return edit_distance_batch_check(query, candidates, results,
+                                     args[parameter::_cost | unit_cost()],
+                                     args[parameter::_equal | default_equal()],
+                                     args[parameter::_substitution | false_type()],
+                                     args[parameter::_max_cost | none()],
+                                     args[parameter::_workspace | nonconst_default<none>()]);
+}
+
+} // detail
+
+// The edit distance of one sequence (the query) to each sequence of a range (the candidates), written
+// in turn to an output iterator, which is returned past the last distance written.  Work that depends
+// on the query alone, such as the match masks of the bit-parallel engines, is done once for the whole
+// range.  The named parameters of edit_distance() apply, except for _script, _max_cost_exception and
+// _snake_index.  With a _max_cost, a distance past it is reported as some cost greater than it.
+template <typename Sequence, typename Candidates, typename OutputIterator>
+inline OutputIterator
+edit_distance_batch(Sequence const& query, Candidates const& candidates, OutputIterator results) {
+    return detail::edit_distance_batch_args(query, candidates, results, detail::edit_distance_batch_parameters()());
+}
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_BATCH_OVERLOAD(z, n, unused) \
+template <typename Sequence, typename Candidates, typename OutputIterator, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline OutputIterator \
+edit_distance_batch(Sequence const& query, Candidates const& candidates, OutputIterator results, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_batch_args(query, candidates, results, detail::edit_distance_batch_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, 6, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_BATCH_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_BATCH_OVERLOAD
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+inline OutputIterator
+edit_distance_top_k_check(Sequence const& query, Candidates const& candidates, const std::size_t& n, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, edit_distance_workspace& workspace) {
+    return detail::edit_distance_top_k_run(as_literal(query), candidates, n, results, cost, equal, allow_sub, max_cost, workspace);
+}
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+inline OutputIterator
+edit_distance_top_k_check(Sequence const& query, Candidates const& candidates, const std::size_t& n, OutputIterator results, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, none&) {
+    detail::default_workspace workspace;
+    return edit_distance_top_k_check(query, candidates, n, results, cost, equal, allow_sub, max_cost, workspace.get());
+}
+
+
+namespace detail {
+
+template <typename Sequence, typename Candidates, typename OutputIterator, typename Args>
+inline OutputIterator
+edit_distance_top_k_args(Sequence const& query, Candidates const& candidates, const std::size_t& n, OutputIterator results, const Args& args) {
+    return edit_distance_top_k_check(query, candidates, n, results,
+                                     args[parameter::_cost | unit_cost()],
+                                     args[parameter::_equal | default_equal()],
+                                     args[parameter::_substitution | false_type()],
+                                     args[parameter::_max_cost | none()],
+                                     args[parameter::_workspace | nonconst_default<none>()]);
+}
+
+} // detail
+
+// The (n) candidates nearest to a query, written to an output iterator as pairs of their position in
+// the range of candidates and their distance, nearest first; of candidates at equal distances, those
+// first in the range.  Fewer are written when there are fewer candidates, or fewer within a
+// _max_cost.  Returns the output iterator past the last written.  The distance of the worst of the
+// nearest found so far is the max cost of each later comparison, at which the engines give up
+// without completing a path, so far candidates cost little.  The other named parameters are those
+// of edit_distance_batch().
+template <typename Sequence, typename Candidates, typename OutputIterator>
+inline OutputIterator
+edit_distance_top_k(Sequence const& query, Candidates const& candidates, const std::size_t& n, OutputIterator results) {
+    return detail::edit_distance_top_k_args(query, candidates, n, results, detail::edit_distance_batch_parameters()());
+}
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_TOP_K_OVERLOAD(z, n, unused) \
+template <typename Sequence, typename Candidates, typename OutputIterator, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline OutputIterator \
+edit_distance_top_k(Sequence const& query, Candidates const& candidates, const std::size_t& k, OutputIterator results, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_top_k_args(query, candidates, k, results, detail::edit_distance_batch_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, 6, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_TOP_K_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_TOP_K_OVERLOAD
+
 
 }}} // boost::algorithm::sequence
 
@@ -0,0 +1,283 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CLUSTER_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CLUSTER_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+
+// Clustering runs in parallel with Boost.Thread, as edit_distance_matrix() does, and so this header
+// also stands apart from edit_distance.hpp
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+// The shape of the locality sensitive hashing of edit_distance_cluster(): each sequence is taken as
+// the set of its q-grams (shingle elements long), and the MinHash signature of that set, (bands)
+// times (rows) hashes, is cut into bands.  Sequences whose signatures agree on a whole band are
+// candidates.  With q-gram sets of Jaccard similarity (s), a pair becomes a candidate with
+// probability 1 - (1 - s^rows)^bands: more bands find more of the close pairs, and more rows make
+// fewer candidates of the far ones.  Passed with the _lsh parameter
+struct edit_distance_lsh {
+    std::size_t bands;
+    std::size_t rows;
+    std::size_t shingle;
+
+    explicit edit_distance_lsh(const std::size_t& bands_ = 32, const std::size_t& rows_ = 3, const std::size_t& shingle_ = 3)
+        : bands(bands_), rows(rows_), shingle(shingle_) {}
+};
+
+namespace detail {
+
+// a 32 bit mixing function, the finalizer of MurmurHash3
+inline boost::uint32_t minhash_mix(boost::uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+struct minhash_shingles {
+    std::vector<boost::uint32_t> h;
+};
+
+// Sets of sequences merged under union by the least index, so that the root of each set is its
+// first sequence.  Any number of threads may find and unite at once, without a lock: a parent is
+// only ever moved to an ancestor, which has a lesser index, by compare and swap, and a union links
+// one root under the other only while it is still a root.  A find may miss a union made meanwhile
+class cluster_forest : private boost::noncopyable {
+public:
+    explicit cluster_forest(const std::size_t& n) : parent(new boost::atomic<boost::uint32_t>[n]) {
+        for (std::size_t j = 0;  j < n;  ++j) parent[j].store(boost::uint32_t(j), boost::memory_order_relaxed);
+    }
+
+    boost::uint32_t find(boost::uint32_t x) {
+        while (true) {
+            boost::uint32_t p = parent[x].load(boost::memory_order_acquire);
+            if (p == x) return x;
+            const boost::uint32_t g = parent[p].load(boost::memory_order_acquire);
+            // path halving: should another thread have moved the parent since, it moved it higher
+            if (g != p) parent[x].compare_exchange_weak(p, g, boost::memory_order_release, boost::memory_order_relaxed);
+            x = g;
+        }
+    }
+
+    void unite(const boost::uint32_t& a, const boost::uint32_t& b) {
+        while (true) {
+            boost::uint32_t ra = find(a);
+            boost::uint32_t rb = find(b);
+            if (ra == rb) return;
+            if (ra > rb) std::swap(ra, rb);
+            boost::uint32_t root = rb;
+            if (parent[rb].compare_exchange_strong(root, ra, boost::memory_order_acq_rel, boost::memory_order_acquire)) return;
+        }
+    }
+
+private:
+    boost::scoped_array<boost::atomic<boost::uint32_t> > parent;
+};
+
+// The clusters of a corpus: the sets of sequences linked by pairs within a max cost (k).  Only pairs
+// that land in a bucket of one band of the locality sensitive hashing (see edit_distance_lsh) are
+// tried, and those already linked through others are skipped.  Band by band, the keys of the
+// sequences are computed in parallel, sorted, and the buckets they make are verified in parallel, a
+// pair at a time under edit_distance_within().  A bucket of (b) sequences is shared out as its
+// b-1 rows, each sequence against those after it, so that one large bucket doesn't fall to a single
+// thread, and the forest is looked up and merged without a lock.  The clusters come out the same on
+// any number of threads
+template <typename Range, typename Cost, typename Equal, typename AllowSub, typename CostT>
+class lsh_clusters : private boost::noncopyable {
+public:
+    lsh_clusters(const std::vector<Range>& corpus_, const CostT& k_, const Cost& cost_, const Equal& equal_, const AllowSub& allow_sub_, const edit_distance_lsh& lsh_)
+        : corpus(corpus_), k(k_), cost(cost_), equal(equal_), allow_sub(allow_sub_), lsh(lsh_), forest(corpus_.size()), band(0) {}
+
+    void run(const std::size_t& threads) {
+        const std::size_t n = corpus.size();
+        for (band = 0;  band < lsh.bands;  ++band) {
+            keys.resize(n);
+            const key_work kw(*this);
+            parallel_run(kw, n, threads);
+            std::sort(keys.begin(), keys.end());
+            bucket_rows.clear();
+            for (std::size_t b = 0, e = 0;  b < n;  b = e) {
+                for (e = b+1;  e < n  &&  keys[e].first == keys[b].first;  ++e);
+                for (std::size_t x = b;  x+1 < e;  ++x) bucket_rows.push_back(std::make_pair(x, e));
+            }
+            const row_work rw(*this);
+            parallel_run(rw, bucket_rows.size(), threads);
+        }
+    }
+
+    boost::uint32_t label(const std::size_t& j) { return forest.find(boost::uint32_t(j)); }
+
+private:
+    struct key_work {
+        lsh_clusters& c;
+        explicit key_work(lsh_clusters& c_) : c(c_) {}
+        void operator()(const std::size_t& b, const std::size_t& e, edit_distance_workspace& workspace) const {
+            for (std::size_t j = b;  j < e;  ++j) c.keys[j] = std::make_pair(c.band_key(j, workspace), boost::uint32_t(j));
+        }
+    };
+
+    struct row_work {
+        lsh_clusters& c;
+        explicit row_work(lsh_clusters& c_) : c(c_) {}
+        void operator()(const std::size_t& b, const std::size_t& e, edit_distance_workspace& workspace) const {
+            for (std::size_t j = b;  j < e;  ++j) c.verify(c.bucket_rows[j].first, c.bucket_rows[j].second, workspace);
+        }
+    };
+
+    // the key of sequence (j) in the current band: its minimum under each of the band's hashes of
+    // its q-grams, combined.  A sequence shorter than a q-gram is taken as one
+    std::size_t band_key(const std::size_t& j, edit_distance_workspace& workspace) const {
+        typedef typename range_iterator<Range const>::type itr_t;
+        workspace_lease<minhash_shingles> s(workspace);
+        s->h.clear();
+        const itr_t b = boost::begin(corpus[j]);
+        const itr_t e = boost::end(corpus[j]);
+        itr_t g = b;
+        std::size_t len = 0;
+        for (;  len < lsh.shingle  &&  g != e;  ++g, ++len);
+        for (itr_t f = b;  ;  ++f, ++g) {
+            std::size_t h = 0;
+            for (itr_t x = f;  x != g;  ++x) boost::hash_combine(h, *x);
+            s->h.push_back(boost::uint32_t(h));
+            if (g == e) break;
+        }
+
+        std::size_t key = 0;
+        for (std::size_t r = 0;  r < lsh.rows;  ++r) {
+            const boost::uint32_t seed = minhash_mix(boost::uint32_t(band*lsh.rows + r) * 2 + 1);
+            boost::uint32_t m = ~boost::uint32_t(0);
+            for (std::size_t x = 0;  x < s->h.size();  ++x) m = std::min(m, minhash_mix(s->h[x] ^ seed));
+            boost::hash_combine(key, m);
+        }
+        return key;
+    }
+
+    // the pairs of row (x) of a bucket that ends at (e) in the sorted keys: (x) with each after it
+    void verify(const std::size_t& x, const std::size_t& e, edit_distance_workspace& workspace) {
+        const boost::uint32_t i = keys[x].second;
+        for (std::size_t y = x+1;  y < e;  ++y) {
+            const boost::uint32_t j = keys[y].second;
+            if (forest.find(i) == forest.find(j)) continue;
+            if (!edit_distance_within_check(corpus[i], corpus[j], k, cost, equal, allow_sub, nonconst_default<none>(), workspace, nonconst_default<none>())) continue;
+            forest.unite(i, j);
+        }
+    }
+
+    const std::vector<Range>& corpus;
+    const CostT k;
+    const Cost cost;
+    const Equal equal;
+    const AllowSub allow_sub;
+    const edit_distance_lsh lsh;
+    cluster_forest forest;
+    std::size_t band;
+    std::vector<std::pair<std::size_t, boost::uint32_t> > keys;
+    // the rows of the buckets: the position of a sequence in the sorted keys, and the end of its bucket
+    std::vector<std::pair<std::size_t, std::size_t> > bucket_rows;
+};
+
+} // detail
+
+template <typename Corpus, typename CostT, typename OutputIterator, typename Cost, typename Equal, typename AllowSub>
+std::size_t
+edit_distance_cluster_check(Corpus const& corpus, const CostT& k, OutputIterator labels, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const std::size_t& threads, const edit_distance_lsh& lsh) {
+    typedef typename range_iterator<Corpus const>::type itr_t;
+    typedef typename range_value<Corpus>::type seq_t;
+    typedef typename range_iterator<seq_t const>::type elt_t;
+    typedef typename detail::cost_type<Cost, typename range_value<seq_t>::type>::type cost_t;
+    std::vector<boost::iterator_range<elt_t> > seqs;
+    for (itr_t j = boost::begin(corpus);  j != boost::end(corpus);  ++j) seqs.push_back(as_literal(*j));
+
+    detail::lsh_clusters<boost::iterator_range<elt_t>, Cost, Equal, AllowSub, cost_t> clusters(seqs, cost_t(k), cost, equal, allow_sub, lsh);
+    clusters.run(threads);
+    std::size_t n = 0;
+    for (std::size_t j = 0;  j < seqs.size();  ++j, ++labels) {
+        const boost::uint32_t r = clusters.label(j);
+        if (r == j) ++n;
+        *labels = std::size_t(r);
+    }
+    return n;
+}
+
+
+namespace detail {
+
+typedef boost::parameter::parameters<
+    boost::parameter::optional<parameter::tag::cost>,
+    boost::parameter::optional<parameter::tag::equal>,
+    boost::parameter::optional<parameter::tag::substitution>,
+    boost::parameter::optional<parameter::tag::threads>,
+    boost::parameter::optional<parameter::tag::lsh>
+> edit_distance_cluster_parameters;
+
+template <typename Corpus, typename CostT, typename OutputIterator, typename Args>
+inline std::size_t
+edit_distance_cluster_args(Corpus const& corpus, const CostT& k, OutputIterator labels, const Args& args) {
+    return edit_distance_cluster_check(corpus, k, labels,
+                                       args[parameter::_cost | unit_cost()],
+                                       args[parameter::_equal | default_equal()],
+                                       args[parameter::_substitution | false_type()],
+                                       args[parameter::_threads | std::size_t(0)],
+                                       args[parameter::_lsh | edit_distance_lsh()]);
+}
+
+} // detail
+
+// Clusters the sequences of a corpus: two sequences within an edit distance of (k) of each other are
+// in the same cluster, as are the clusters they link.  For each sequence in turn, the position of
+// the first sequence of its cluster is written to an output iterator.  Returns the number of
+// clusters.  Candidate pairs come from locality sensitive hashing of the q-grams of the sequences
+// (see edit_distance_lsh and the _lsh parameter), so a corpus is clustered in time close to linear
+// in its size, but a close pair may be missed, with a probability the hashing sets; a link is
+// only ever made by a pair verified to be within (k).  Elements are hashed with boost::hash, which
+// should agree with the equality used.  The work is shared out between a number of threads given
+// with _threads, by default one per hardware thread.  The named parameters _cost, _equal and
+// _substitution apply as for edit_distance().
+template <typename Corpus, typename CostT, typename OutputIterator>
+inline std::size_t
+edit_distance_cluster(Corpus const& corpus, const CostT& k, OutputIterator labels) {
+    return detail::edit_distance_cluster_args(corpus, k, labels, detail::edit_distance_cluster_parameters()());
+}
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CLUSTER_OVERLOAD(z, n, unused) \
+template <typename Corpus, typename CostT, typename OutputIterator, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline std::size_t \
+edit_distance_cluster(Corpus const& corpus, const CostT& k, OutputIterator labels, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_cluster_args(corpus, k, labels, detail::edit_distance_cluster_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, 6, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CLUSTER_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_CLUSTER_OVERLOAD
+
+}}} // boost::algorithm::sequence
+
+#endif
@@ -0,0 +1,306 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_JOIN_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_JOIN_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+// The pairs of records, one from each of two sides, within a unit cost edit distance (k), found by
+// the partition filter of Pass-Join:
+//     Pass-Join: A Partition-based Method for Similarity Joins
+//     by Guoliang Li, Dong Deng, Jiannan Wang and Jianhua Feng, PVLDB 5(3), 2011
+// A record of length (l) is cut into k+1 segments, and as k edits can touch at most k of them, a
+// record within (k) of it holds one of them unchanged as a substring.  Records are visited in order
+// of length.  Each is looked up first in the segments of the shorter records of the other side seen
+// so far, at only the start positions a match could fall on, and then has its own segments filed.
+// Records too short to cut are compared with every record in reach of their length.  In a self
+// join both sides are the same.  Records are copied into one buffer, as their elements are visited
+// at random
+template <typename Value>
+class join_partition : private boost::noncopyable {
+public:
+    typedef unit_cost::cost_type cost_t;
+    typedef typename std::vector<Value>::const_iterator itr_t;
+    typedef boost::iterator_range<itr_t> range_t;
+
+    // a self join has one side, a join of two corpora two
+    join_partition(const cost_t& k_, const int& sides_) : k(k_), sides(sides_) {}
+
+    // appends a record of side (s), numbered (n) within its side
+    template <typename Range>
+    void push_back(Range const& seq, const int& s, const std::size_t& n) {
+        record r;
+        r.begin = elements.size();
+        elements.insert(elements.end(), boost::begin(seq), boost::end(seq));
+        r.length = elements.size() - r.begin;
+        r.side = s;
+        r.number = n;
+        records.push_back(r);
+    }
+
+    // calls f(a, b, d) with the numbers of each pair within (k), the record of side 0 first, and
+    // their distance; in a self join (a < b).  Returns the number of pairs
+    template <typename AllowSub, typename Callback>
+    std::size_t run(const AllowSub& allow_sub, Callback& f, edit_distance_workspace& workspace) {
+        std::vector<boost::uint32_t> order(records.size());
+        for (std::size_t j = 0;  j < order.size();  ++j) order[j] = boost::uint32_t(j);
+        std::stable_sort(order.begin(), order.end(), shorter(records));
+        std::vector<side_index> index(sides);
+        mark.assign(records.size(), 0);
+        stamp = 0;
+
+        const max_cost_bound<cost_t> max_cost(k);
+        std::size_t pairs = 0;
+        for (std::size_t x = 0;  x < order.size();  ++x) {
+            const record& r = records[order[x]];
+            const range_t rr = range(r);
+            side_index& probe = index[sides - 1 - r.side];
+            batch_query<range_t, unit_cost, default_equal, AllowSub> verify(rr, unit_cost(), default_equal(), allow_sub);
+            candidates.clear();
+            ++stamp;
+            for (std::size_t j = 0;  j < probe.shorts.size();  ++j) candidate(probe.shorts[j]);
+            probe_segments(r, probe);
+            for (std::size_t j = 0;  j < candidates.size();  ++j) {
+                const record& c = records[candidates[j]];
+                if (r.length - c.length > k) continue;
+                const cost_t d = verify(range(c), max_cost, workspace);
+                if (d > k) continue;
+                ++pairs;
+                if (sides == 1) f(std::min(r.number, c.number), std::max(r.number, c.number), d);
+                else if (r.side == 0) f(r.number, c.number, d);
+                else f(c.number, r.number, d);
+            }
+            file(order[x], index[r.side]);
+        }
+        return pairs;
+    }
+
+private:
+    struct record {
+        std::size_t begin;
+        std::size_t length;
+        int side;
+        std::size_t number;
+    };
+
+    struct shorter {
+        const std::vector<record>& records;
+        explicit shorter(const std::vector<record>& records_) : records(records_) {}
+        inline bool operator()(const boost::uint32_t& a, const boost::uint32_t& b) const { return records[a].length < records[b].length; }
+    };
+
+    // the segments filed for the records of one side, under keys of the record length, segment
+    // number and contents.  Keys that collide only make more candidates
+    struct side_index {
+        boost::unordered_map<std::size_t, std::vector<boost::uint32_t> > segments;
+        std::vector<boost::uint32_t> shorts;
+    };
+
+    range_t range(const record& r) const {
+        return range_t(elements.begin() + r.begin, elements.begin() + (r.begin + r.length));
+    }
+
+    // segment (i) of a record of length (l): the first k+1 - l%(k+1) segments are the shorter
+    inline std::size_t segment_length(const std::size_t& l, const std::size_t& i) const {
+        return l/(k+1) + ((i + l%(k+1) >= k+1) ? 1 : 0);
+    }
+    inline std::size_t segment_start(const std::size_t& l, const std::size_t& i) const {
+        const std::size_t shorter = k+1 - l%(k+1);
+        return i*(l/(k+1)) + ((i > shorter) ? i - shorter : 0);
+    }
+
+    static inline std::size_t segment_key(const std::size_t& l, const std::size_t& i, const itr_t& b, const std::size_t& len) {
+        std::size_t h = boost::hash_range(b, b + len);
+        boost::hash_combine(h, l);
+        boost::hash_combine(h, i);
+        return h;
+    }
+
+    inline void candidate(const boost::uint32_t& c) {
+        if (mark[c] == stamp) return;
+        mark[c] = stamp;
+        candidates.push_back(c);
+    }
+
+    void file(const boost::uint32_t& x, side_index& index) {
+        const record& r = records[x];
+        if (r.length <= k) {
+            index.shorts.push_back(x);
+            return;
+        }
+        const itr_t b = elements.begin() + r.begin;
+        for (std::size_t i = 0;  i <= k;  ++i) {
+            index.segments[segment_key(r.length, i, b + segment_start(r.length, i), segment_length(r.length, i))].push_back(x);
+        }
+    }
+
+    // Looks up the segments of records of each length (ls) in reach of record (r), no longer than it.
+    // Segment (i) can only match at start positions of (r) that leave at most (i) edits before it,
+    // and at most k-i after it, on either record: the multi-match-aware selection of Pass-Join
+    void probe_segments(const record& r, const side_index& index) {
+        const itr_t b = elements.begin() + r.begin;
+        const std::size_t lr = r.length;
+        for (std::size_t ls = std::max(lr, k) - k;  ls <= lr;  ++ls) {
+            if (ls <= k) continue;
+            const std::ptrdiff_t delta = std::ptrdiff_t(lr - ls);
+            for (std::size_t i = 0;  i <= k;  ++i) {
+                const std::ptrdiff_t p = std::ptrdiff_t(segment_start(ls, i));
+                const std::ptrdiff_t len = std::ptrdiff_t(segment_length(ls, i));
+                const std::ptrdiff_t a = std::ptrdiff_t(i);
+                const std::ptrdiff_t z = std::ptrdiff_t(k - i);
+                const std::ptrdiff_t lo = std::max(std::max(p - a, p + delta - z), std::ptrdiff_t(0));
+                const std::ptrdiff_t hi = std::min(std::min(p + a, p + delta + z), std::ptrdiff_t(lr) - len);
+                for (std::ptrdiff_t pos = lo;  pos <= hi;  ++pos) {
+                    const typename boost::unordered_map<std::size_t, std::vector<boost::uint32_t> >::const_iterator
+                        s = index.segments.find(segment_key(ls, i, b + pos, std::size_t(len)));
+                    if (s == index.segments.end()) continue;
+                    for (std::size_t j = 0;  j < s->second.size();  ++j) candidate(s->second[j]);
+                }
+            }
+        }
+    }
+
+    const cost_t k;
+    const int sides;
+    std::vector<Value> elements;
+    std::vector<record> records;
+    std::vector<boost::uint32_t> mark;
+    boost::uint32_t stamp;
+    std::vector<boost::uint32_t> candidates;
+};
+
+template <typename Corpus>
+struct join_value {
+    typedef typename boost::remove_cv<typename range_value<typename range_value<Corpus>::type>::type>::type type;
+};
+
+} // detail
+
+template <typename Corpus, typename Callback, typename AllowSub>
+std::size_t
+edit_distance_join_check(Corpus const& corpus, const unit_cost::cost_type& k, Callback f, const AllowSub& allow_sub, edit_distance_workspace& workspace) {
+    detail::join_partition<typename detail::join_value<Corpus>::type> join(k, 1);
+    std::size_t n = 0;
+    for (typename range_iterator<Corpus const>::type j = boost::begin(corpus);  j != boost::end(corpus);  ++j, ++n) join.push_back(as_literal(*j), 0, n);
+    return join.run(allow_sub, f, workspace);
+}
+
+template <typename Corpus1, typename Corpus2, typename Callback, typename AllowSub>
+std::size_t
+edit_distance_join_check(Corpus1 const& corpus1, Corpus2 const& corpus2, const unit_cost::cost_type& k, Callback f, const AllowSub& allow_sub, edit_distance_workspace& workspace) {
+    detail::join_partition<typename detail::join_value<Corpus1>::type> join(k, 2);
+    std::size_t n = 0;
+    for (typename range_iterator<Corpus1 const>::type j = boost::begin(corpus1);  j != boost::end(corpus1);  ++j, ++n) join.push_back(as_literal(*j), 0, n);
+    n = 0;
+    for (typename range_iterator<Corpus2 const>::type j = boost::begin(corpus2);  j != boost::end(corpus2);  ++j, ++n) join.push_back(as_literal(*j), 1, n);
+    return join.run(allow_sub, f, workspace);
+}
+
+template <typename Corpus, typename Callback, typename AllowSub>
+inline std::size_t
+edit_distance_join_check(Corpus const& corpus, const unit_cost::cost_type& k, Callback f, const AllowSub& allow_sub, none&) {
+    detail::default_workspace workspace;
+    return edit_distance_join_check(corpus, k, f, allow_sub, workspace.get());
+}
+
+template <typename Corpus1, typename Corpus2, typename Callback, typename AllowSub>
+inline std::size_t
+edit_distance_join_check(Corpus1 const& corpus1, Corpus2 const& corpus2, const unit_cost::cost_type& k, Callback f, const AllowSub& allow_sub, none&) {
+    detail::default_workspace workspace;
+    return edit_distance_join_check(corpus1, corpus2, k, f, allow_sub, workspace.get());
+}
+
+
+namespace detail {
+
+typedef boost::parameter::parameters<
+    boost::parameter::optional<parameter::tag::substitution>,
+    boost::parameter::optional<parameter::tag::workspace>
+> edit_distance_join_parameters;
+
+template <typename Corpus, typename Callback, typename Args>
+inline std::size_t
+edit_distance_join_args(Corpus const& corpus, const unit_cost::cost_type& k, Callback f, const Args& args) {
+    return edit_distance_join_check(corpus, k, f,
+                                    args[parameter::_substitution | false_type()],
+                                    args[parameter::_workspace | nonconst_default<none>()]);
+}
+
+template <typename Corpus1, typename Corpus2, typename Callback, typename Args>
+inline std::size_t
+edit_distance_join_args(Corpus1 const& corpus1, Corpus2 const& corpus2, const unit_cost::cost_type& k, Callback f, const Args& args) {
+    return edit_distance_join_check(corpus1, corpus2, k, f,
+                                    args[parameter::_substitution | false_type()],
+                                    args[parameter::_workspace | nonconst_default<none>()]);
+}
+
+} // detail
+
+// Calls f(i, j, d) for every pair of sequences (i) < (j) of a corpus, by their positions, whose unit
+// cost edit distance (d) is at most (k), and returns the number of them.  Only pairs that share a
+// segment under the partition filter of Pass-Join are compared, under a max cost of (k) (see
+// join_partition), so the time grows with the pairs that come close, not with all pairs.  Elements
+// are compared with operator== and hashed with boost::hash.  The named parameters _substitution and
+// _workspace apply as for edit_distance()
+template <typename Corpus, typename K, typename Callback>
+inline typename boost::enable_if<boost::is_arithmetic<K>, std::size_t>::type
+edit_distance_join(Corpus const& corpus, const K& k, Callback f) {
+    return detail::edit_distance_join_args(corpus, unit_cost::cost_type(k), f, detail::edit_distance_join_parameters()());
+}
+
+// As above, for pairs of a sequence (i) of corpus1 and a sequence (j) of corpus2
+template <typename Corpus1, typename Corpus2, typename K, typename Callback>
+inline typename boost::enable_if<boost::is_arithmetic<K>, std::size_t>::type
+edit_distance_join(Corpus1 const& corpus1, Corpus2 const& corpus2, const K& k, Callback f) {
+    return detail::edit_distance_join_args(corpus1, corpus2, unit_cost::cost_type(k), f, detail::edit_distance_join_parameters()());
+}
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_JOIN_OVERLOAD(z, n, unused) \
+template <typename Corpus, typename K, typename Callback, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline typename boost::enable_if<boost::is_arithmetic<K>, std::size_t>::type \
+edit_distance_join(Corpus const& corpus, const K& k, Callback f, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_join_args(corpus, unit_cost::cost_type(k), f, detail::edit_distance_join_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+} \
+template <typename Corpus1, typename Corpus2, typename K, typename Callback, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline typename boost::enable_if<boost::is_arithmetic<K>, std::size_t>::type \
+edit_distance_join(Corpus1 const& corpus1, Corpus2 const& corpus2, const K& k, Callback f, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_join_args(corpus1, corpus2, unit_cost::cost_type(k), f, detail::edit_distance_join_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, 3, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_JOIN_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_JOIN_OVERLOAD
+
+}}} // boost::algorithm::sequence
+
+#endif
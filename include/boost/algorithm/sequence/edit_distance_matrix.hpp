@@ -0,0 +1,158 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_MATRIX_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_MATRIX_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_parallel.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Computing a matrix in parallel uses Boost.Thread, which is why this header stands apart from
+// edit_distance.hpp: programs that include it link with boost_thread
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+// The position of the distance between sequences (i) and (j), i < j, of a corpus of (n) sequences,
+// in the condensed matrix written by edit_distance_matrix(): the rows of the upper triangle, in turn
+inline std::size_t edit_distance_matrix_index(const std::size_t& n, const std::size_t& i, const std::size_t& j) {
+    return i*n - (i*(i+1))/2 + (j-i-1);
+}
+
+namespace detail {
+
+// a distance past a max cost is stored as the first cost past it
+template <typename CostT>
+inline CostT matrix_entry(const CostT& d, const none&) { return d; }
+
+template <typename CostT, typename MaxCost>
+inline CostT matrix_entry(const CostT& d, const MaxCost& max_cost) {
+    const CostT k = CostT(max_cost_abs(max_cost));
+    return (d > k) ? k + CostT(1) : d;
+}
+
+// The entries of the condensed matrix of a corpus, computed a range at a time (see parallel_run)
+template <typename Itr, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+class matrix_entries {
+public:
+    matrix_entries(const std::vector<Itr>& corpus_, OutputIterator out_, const Cost& cost_, const Equal& equal_, const AllowSub& allow_sub_, const MaxCost& max_cost_)
+        : corpus(corpus_), n(corpus_.size()), out(out_), cost(cost_), equal(equal_), allow_sub(allow_sub_), max_cost(max_cost_) {}
+
+    // the entries [b, e) of the condensed matrix
+    void operator()(const std::size_t& b, const std::size_t& e, edit_distance_workspace& workspace) const {
+        std::size_t i = row(b);
+        std::size_t j = i+1 + (b - edit_distance_matrix_index(n, i, i+1));
+        for (std::size_t x = b;  x < e;  ++x) {
+            out[x] = matrix_entry(edit_distance_check(*corpus[i], *corpus[j], nonconst_default<none>(), cost, equal, allow_sub, max_cost, false, nonconst_default<none>(), workspace), max_cost);
+            if (++j >= n) {
+                ++i;
+                j = i+1;
+            }
+        }
+    }
+
+private:
+    // the row holding entry (x)
+    std::size_t row(const std::size_t& x) const {
+        std::size_t lo = 0;
+        std::size_t hi = n-1;
+        while (hi - lo > 1) {
+            const std::size_t mid = lo + (hi-lo)/2;
+            if (edit_distance_matrix_index(n, mid, mid+1) <= x) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    const std::vector<Itr>& corpus;
+    const std::size_t n;
+    OutputIterator out;
+    Cost cost;
+    Equal equal;
+    AllowSub allow_sub;
+    MaxCost max_cost;
+};
+
+} // detail
+
+template <typename Corpus, typename OutputIterator, typename Cost, typename Equal, typename AllowSub, typename MaxCost>
+OutputIterator
+edit_distance_matrix_check(Corpus const& corpus, OutputIterator out, const Cost& cost, const Equal& equal, const AllowSub& allow_sub, const MaxCost& max_cost, const std::size_t& threads) {
+    typedef typename range_iterator<Corpus const>::type itr_t;
+    std::vector<itr_t> seqs;
+    for (itr_t j = boost::begin(corpus);  j != boost::end(corpus);  ++j) seqs.push_back(j);
+    const std::size_t n = seqs.size();
+    const std::size_t pairs = (n < 2) ? 0 : (n*(n-1))/2;
+    if (pairs == 0) return out;
+
+    const detail::matrix_entries<itr_t, OutputIterator, Cost, Equal, AllowSub, MaxCost> entries(seqs, out, cost, equal, allow_sub, max_cost);
+    detail::parallel_run(entries, pairs, threads);
+    return out + pairs;
+}
+
+
+namespace detail {
+
+typedef boost::parameter::parameters<
+    boost::parameter::optional<parameter::tag::cost>,
+    boost::parameter::optional<parameter::tag::equal>,
+    boost::parameter::optional<parameter::tag::substitution>,
+    boost::parameter::optional<parameter::tag::max_cost>,
+    boost::parameter::optional<parameter::tag::threads>
+> edit_distance_matrix_parameters;
+
+template <typename Corpus, typename OutputIterator, typename Args>
+inline OutputIterator
+edit_distance_matrix_args(Corpus const& corpus, OutputIterator out, const Args& args) {
+    return edit_distance_matrix_check(corpus, out,
+                                      args[parameter::_cost | unit_cost()],
+                                      args[parameter::_equal | default_equal()],
+                                      args[parameter::_substitution | false_type()],
+                                      args[parameter::_max_cost | none()],
+                                      args[parameter::_threads | std::size_t(0)]);
+}
+
+} // detail
+
+// The edit distance between every pair of sequences of a corpus, written to the condensed matrix
+// starting at a random access iterator (see edit_distance_matrix_index).  Returns the iterator past
+// the last entry, n(n-1)/2 of them for (n) sequences.  The pairs are shared out between a number of
+// threads given with _threads, by default one per hardware thread.  The named parameters _cost,
+// _equal and _substitution apply as for edit_distance().  With a _max_cost, distances past it are
+// stored as the first cost past it.  Since any random access iterator will do, the matrix may be
+// kept in a memory mapped file, for a corpus whose matrix is larger than memory.
+template <typename Corpus, typename OutputIterator>
+inline OutputIterator
+edit_distance_matrix(Corpus const& corpus, OutputIterator out) {
+    return detail::edit_distance_matrix_args(corpus, out, detail::edit_distance_matrix_parameters()());
+}
+
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_MATRIX_OVERLOAD(z, n, unused) \
+template <typename Corpus, typename OutputIterator, BOOST_PP_ENUM_PARAMS(n, typename A)> \
+inline OutputIterator \
+edit_distance_matrix(Corpus const& corpus, OutputIterator out, BOOST_PP_ENUM_BINARY_PARAMS(n, A, const& a)) { \
+    return detail::edit_distance_matrix_args(corpus, out, detail::edit_distance_matrix_parameters()(BOOST_PP_ENUM_PARAMS(n, a))); \
+}
+
+BOOST_PP_REPEAT_FROM_TO(1, 6, BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_MATRIX_OVERLOAD, ~)
+
+#undef BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_MATRIX_OVERLOAD
+
+}}} // boost::algorithm::sequence
+
+#endif
@@ -0,0 +1,288 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_STREAM_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_EDIT_DISTANCE_STREAM_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/type_traits/remove_cv.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+// The sum of the vertical deltas of four rows, and the least of their running sums (or zero), for
+// every four bits of +1 deltas (high half of the index) and -1 deltas (low half)
+struct stream_nibbles {
+    signed char sum[256];
+    signed char least[256];
+
+    stream_nibbles() {
+        for (int x = 0;  x < 256;  ++x) {
+            int c = 0;
+            least[x] = 0;
+            for (int r = 0;  r < 4;  ++r) {
+                c += ((x >> (4+r)) & 1) - ((x >> r) & 1);
+                if (c < least[x]) least[x] = (signed char)(c);
+            }
+            sum[x] = (signed char)(c);
+        }
+    }
+};
+
+// Folds the vertical deltas of one block of a column into the least cell seen so far.  (cur) is the
+// cell above the block on entry, and its bottom cell on return.  The cells of a block can fall below
+// the one above it by at most its -1 deltas, and only then are the deltas walked, four rows at a time
+inline void stream_column_min(std::ptrdiff_t& cur, std::ptrdiff_t& least, const bitvec_t& Pv, const bitvec_t& Mv, const std::ptrdiff_t& hb, const stream_nibbles& nibbles) {
+    if (cur - bitvec_popcount(Mv) >= least) {
+        cur += bitvec_popcount(Pv) - bitvec_popcount(Mv);
+        return;
+    }
+    for (std::ptrdiff_t r = 0;  r < hb;  r += 4) {
+        const unsigned int x = unsigned(((Pv >> r) & 15) << 4) | unsigned((Mv >> r) & 15);
+        least = std::min(least, cur + nibbles.least[x]);
+        cur += nibbles.sum[x];
+    }
+}
+
+// the bits of block (b) that hold rows of a pattern of length (m)
+inline bitvec_t stream_block_rows(const std::ptrdiff_t& m, const std::ptrdiff_t& b) {
+    const std::ptrdiff_t hb = std::min(m - b*bitvec_bits, bitvec_bits);
+    return (hb < bitvec_bits) ? ((bitvec_t(1) << hb) - 1) : ~bitvec_t(0);
+}
+
+// In general, the last column of the edit graph of the first sequence against the elements of the
+// second so far: each element appended is a new column, from the last one, in O(m) work
+template <typename Value, typename Cost, typename Equal, typename AllowSub, typename Enable = void>
+class stream_column {
+public:
+    typedef typename cost_type<Cost, Value>::type cost_t;
+
+    stream_column(const std::vector<Value>& P_, const Cost& cost_, const Equal& equal_, const AllowSub& allow_sub_)
+        : P(P_), cost(cost_), equal(equal_), allow_sub(allow_sub_) {
+        clear();
+    }
+
+    void clear() {
+        C.resize(P.size()+1);
+        C[0] = 0;
+        for (std::size_t i = 1;  i <= P.size();  ++i) C[i] = C[i-1] + cost.deletion(P[i-1]);
+    }
+
+    void push_back(const Value& v) {
+        const sub_checker<AllowSub, Cost, cost_t, none> sub(allow_sub);
+        const cost_t ins = cost.insertion(v);
+        cost_t diag = C[0];
+        C[0] += ins;
+        for (std::size_t i = 1;  i <= P.size();  ++i) {
+            const cost_t left = C[i];
+            cost_t c = std::min(left + ins, C[i-1] + cost.deletion(P[i-1]));
+            if (equal(P[i-1], v)) c = std::min(c, diag);
+            else if (sub()) c = std::min(c, diag + sub.substitution(cost, P[i-1], v));
+            C[i] = c;
+            diag = left;
+        }
+    }
+
+    cost_t distance() const { return C.back(); }
+    cost_t prefix_distance() const { return *std::min_element(C.begin(), C.end()); }
+
+private:
+    const std::vector<Value> P;
+    Cost cost;
+    Equal equal;
+    AllowSub allow_sub;
+    std::vector<cost_t> C;
+};
+
+// Under unit costs with substitution, for integral elements under default equality, the column is
+// held as the vertical deltas of Myers' bit-parallel engine (see bitparallel_banded_distance), in
+// blocks of bitvec_bits rows: a new column is O(m/w) word operations
+template <typename Value, typename Equal>
+class stream_column<Value, unit_cost, Equal, boost::true_type,
+                    typename enable_if<and_<is_default_equal<Equal>, is_integral<Value>, not_<is_same<Value, bool> > > >::type> {
+public:
+    typedef unit_cost::cost_type cost_t;
+
+    stream_column(const std::vector<Value>& P, const unit_cost&, const Equal&, const boost::true_type&)
+        : m(P.size()), B((m + bitvec_bits-1) / bitvec_bits), peq(P.begin(), m, default_equal()) {
+        clear();
+    }
+
+    void clear() {
+        n = 0;
+        blocks.Pv.assign(B, ~bitvec_t(0));
+        blocks.Mv.assign(B, bitvec_t(0));
+        blocks.score.resize(B);
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) blocks.score[b] = std::min(m, (b+1)*bitvec_bits);
+    }
+
+    void push_back(const Value& v) {
+        ++n;
+        // the top row is D(0,n) = n, a +1 delta from the last column
+        int h = 1;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) {
+            const bitvec_t hbit = bitvec_t(1) << (std::min(m - b*bitvec_bits, bitvec_bits) - 1);
+            h = bitparallel_block(blocks.Pv[b], blocks.Mv[b], peq(v, b), h, hbit);
+            blocks.score[b] += h;
+        }
+    }
+
+    cost_t distance() const { return cost_t((B > 0) ? blocks.score[B-1] : n); }
+
+    cost_t prefix_distance() const {
+        std::ptrdiff_t cur = n;
+        std::ptrdiff_t least = n;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) {
+            const bitvec_t rows = stream_block_rows(m, b);
+            stream_column_min(cur, least, blocks.Pv[b] & rows, blocks.Mv[b] & rows, std::min(m - b*bitvec_bits, bitvec_bits), nibbles);
+        }
+        return cost_t(least);
+    }
+
+private:
+    typedef typename std::vector<Value>::const_iterator itrp_t;
+
+    std::ptrdiff_t m;
+    std::ptrdiff_t B;
+    std::ptrdiff_t n;
+    block_match_mask<itrp_t, itrp_t, default_equal> peq;
+    stream_nibbles nibbles;
+    bitvec_blocks blocks;
+};
+
+// Under unit costs without substitution, the column is held as the bit vector of the bit-parallel
+// longest common subsequence (see bitparallel_lcs), whose zero bits among its first (i) rows count
+// the common subsequence of the first (i) elements: D(i,n) = i + n - 2*LCS(i).  A new column is
+// O(m/w) word operations
+template <typename Value, typename Equal>
+class stream_column<Value, unit_cost, Equal, boost::false_type,
+                    typename enable_if<and_<is_default_equal<Equal>, is_integral<Value>, not_<is_same<Value, bool> > > >::type> {
+public:
+    typedef unit_cost::cost_type cost_t;
+
+    stream_column(const std::vector<Value>& P, const unit_cost&, const Equal&, const boost::false_type&)
+        : m(P.size()), B((m + bitvec_bits-1) / bitvec_bits), peq(P.begin(), m, default_equal()) {
+        clear();
+    }
+
+    void clear() {
+        n = 0;
+        V.assign(B, ~bitvec_t(0));
+    }
+
+    void push_back(const Value& v) {
+        ++n;
+        bitvec_t carry = 0;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) {
+            const bitvec_t U = V[b] & peq(v, b);
+            const bitvec_t s = V[b] + U;
+            const bitvec_t x = s + carry;
+            carry = bitvec_t((s < V[b]) | (x < s));
+            V[b] = x | (V[b] - U);
+        }
+    }
+
+    cost_t distance() const {
+        // bits of the last block beyond (m) stay set
+        std::ptrdiff_t ones = 0;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) ones += bitvec_popcount(V[b]);
+        return cost_t(m + n - 2*(B*bitvec_bits - ones));
+    }
+
+    cost_t prefix_distance() const {
+        std::ptrdiff_t cur = n;
+        std::ptrdiff_t least = n;
+        for (std::ptrdiff_t b = 0;  b < B;  ++b) {
+            const bitvec_t rows = stream_block_rows(m, b);
+            stream_column_min(cur, least, V[b] & rows, ~V[b] & rows, std::min(m - b*bitvec_bits, bitvec_bits), nibbles);
+        }
+        return cost_t(least);
+    }
+
+private:
+    typedef typename std::vector<Value>::const_iterator itrp_t;
+
+    std::ptrdiff_t m;
+    std::ptrdiff_t B;
+    std::ptrdiff_t n;
+    block_match_mask<itrp_t, itrp_t, default_equal> peq;
+    stream_nibbles nibbles;
+    std::vector<bitvec_t> V;
+};
+
+} // detail
+
+// The edit distance of a sequence against a second one that arrives an element at a time.  The
+// last column of the edit graph is kept, and each element appended to the second sequence costs
+// one new column, after which the distance to the whole of the first sequence, or to the nearest
+// of its prefixes (how far along it the second sequence has come), is read from the column: a
+// session of (n) elements costs O(mn), rather than the O(mn^2) of a distance from scratch after
+// each.  Under unit costs, for integral elements under default equality, columns are bit-parallel:
+// appending and reading the distance cost O(m/w) word operations, and the nearest prefix is read
+// four rows at a time, in only the blocks that might hold it.  Distances are those of
+// edit_distance(seq1, seq2) with the same cost, substitution and equality.
+template <typename Sequence, typename Cost = unit_cost, typename AllowSub = boost::false_type, typename Equal = default_equal>
+class edit_distance_stream {
+public:
+    typedef typename boost::remove_cv<typename range_value<Sequence>::type>::type value_type;
+    typedef typename detail::cost_type<Cost, value_type>::type cost_type;
+    typedef std::size_t size_type;
+
+    explicit edit_distance_stream(const Sequence& seq1, const Cost& cost = Cost(), const AllowSub& allow_sub = AllowSub(), const Equal& equal = Equal())
+        : m(std::size_t(boost::distance(as_literal(seq1)))),
+          column(std::vector<value_type>(boost::begin(as_literal(seq1)), boost::end(as_literal(seq1))), cost, equal, allow_sub), n(0) {}
+
+    // the length of the first sequence, and of the second so far
+    size_type pattern_size() const { return m; }
+    size_type size() const { return n; }
+    bool empty() const { return n == 0; }
+
+    // restarts the second sequence, from empty
+    void clear() {
+        column.clear();
+        n = 0;
+    }
+
+    void push_back(const value_type& v) {
+        column.push_back(v);
+        ++n;
+    }
+
+    template <typename InputIterator>
+    void append(InputIterator first, InputIterator last) {
+        for (;  first != last;  ++first) push_back(*first);
+    }
+
+    // the distance of the first sequence from the second so far
+    cost_type distance() const { return column.distance(); }
+
+    // the least distance of any prefix of the first sequence from the second so far
+    cost_type prefix_distance() const { return column.prefix_distance(); }
+
+private:
+    size_type m;
+    detail::stream_column<value_type, Cost, Equal, AllowSub> column;
+    size_type n;
+};
+
+}}} // boost::algorithm::sequence
+
+#endif
@@ -0,0 +1,326 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_INCREMENTAL_EDIT_SCRIPT_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_INCREMENTAL_EDIT_SCRIPT_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+// edit operations of a retained script, each held as a run of the same operation
+enum { script_eql, script_sub, script_ins, script_del };
+
+template <typename CostT>
+struct script_run {
+    int op;
+    std::size_t length;
+    CostT cost;
+    script_run(const int& op_, const std::size_t& length_, const CostT& cost_) : op(op_), length(length_), cost(cost_) {}
+};
+
+// appends a run, merged into the last one if it is of the same operation
+template <typename CostT>
+inline void push_script_run(std::vector<script_run<CostT> >& runs, const int& op, const std::size_t& length, const CostT& cost) {
+    if (length == 0) return;
+    if (!runs.empty()  &&  runs.back().op == op) {
+        runs.back().length += length;
+        runs.back().cost += cost;
+    } else {
+        runs.push_back(script_run<CostT>(op, length, cost));
+    }
+}
+
+// a script handler that records the script it is given as runs
+template <typename Value, typename CostT>
+struct script_recorder {
+    typedef Value value_type;
+    typedef CostT cost_type;
+    std::vector<script_run<CostT> >& runs;
+    explicit script_recorder(std::vector<script_run<CostT> >& runs_) : runs(runs_) {}
+
+    inline void insertion(const Value&, const CostT& c) { push_script_run(runs, script_ins, 1, c); }
+    inline void deletion(const Value&, const CostT& c) { push_script_run(runs, script_del, 1, c); }
+    inline void substitution(const Value&, const Value&, const CostT& c) { push_script_run(runs, script_sub, 1, c); }
+    inline void equality(const Value&, const Value&) { push_script_run(runs, script_eql, 1, CostT(0)); }
+};
+
+} // detail
+
+// The edit script of two sequences, kept up to date as either of them is edited in place.  The
+// script is held as runs of equal operations, and an edit of a range of one sequence re-diffs only a
+// window around it: the runs of the old script that touch the range, the runs of insertions,
+// deletions or substitutions next to them, and up to (context) equal elements on either side.  The
+// rest of the script is kept as it was.  So an edit costs the diff of its window, plus a pass over
+// the runs, which number about twice the edits between the sequences, rather than a diff of the
+// whole; the sequences themselves are held as vectors, and an edit that changes the length of one
+// moves the elements after it.  The script is minimal within each window, but as with any local
+// re-diff, the whole can cost more than a diff from scratch.  So the script keeps a bound on that
+// excess, excess(): an edit can lower the edit distance by no more than the cost of undoing it, so
+// each one adds that cost, less what its window saves, and a diff of the whole clears it.  The bound
+// is loose (an element typed and still unmatched adds twice its cost) so an edit never diffs the
+// whole for it: once the bound passes slack(), 16 by default, the next call of script(), which
+// passes over the whole anyway, first diffs the whole again.  So the script it gives is never more
+// than slack() above the edit distance, and a slack of 0 makes it minimal.  The bound holds for
+// costs under which edit distance obeys the triangle inequality, such as unit_cost.
+// Costs, equality and substitution are those of edit_distance(seq1, seq2, _script=...).
+template <typename Sequence, typename Cost = unit_cost, typename AllowSub = boost::false_type, typename Equal = default_equal>
+class incremental_edit_script {
+public:
+    typedef typename boost::remove_cv<typename range_value<Sequence>::type>::type value_type;
+    typedef typename detail::cost_type<Cost, value_type>::type cost_type;
+    typedef std::size_t size_type;
+
+    incremental_edit_script(const Sequence& seq1, const Sequence& seq2, const std::size_t& context_ = 16,
+                            const Cost& cost_ = Cost(), const AllowSub& allow_sub_ = AllowSub(), const Equal& equal_ = Equal())
+        : S1(boost::begin(as_literal(seq1)), boost::end(as_literal(seq1))), S2(boost::begin(as_literal(seq2)), boost::end(as_literal(seq2))),
+          context(context_), cost(cost_), allow_sub(allow_sub_), equal(equal_), slack_cost(16), diffs(0) {
+        diff();
+    }
+
+    const std::vector<value_type>& first() const { return S1; }
+    const std::vector<value_type>& second() const { return S2; }
+
+    // The cost of the script held, which is the edit distance of the sequences after diff(), and
+    // after an edit may be above it, by at most excess()
+    cost_type script_cost() const { return total; }
+    cost_type excess() const { return excess_bound; }
+
+    // the excess past which script() diffs the whole first
+    cost_type slack() const { return slack_cost; }
+    void slack(const cost_type& c) { slack_cost = c; }
+
+    // the number of diffs of the whole made so far, including the first
+    size_type full_diffs() const { return diffs; }
+
+    // the number of runs of equal operations in the script
+    size_type runs() const { return ops.size(); }
+
+    // Replaces (count) elements of the first or second sequence from position (pos) with the
+    // elements [first, last), and re-diffs the window around them.  Returns the cost of the new script
+    template <typename InputIterator>
+    cost_type replace_first(const size_type& pos, const size_type& count, InputIterator first, InputIterator last) {
+        return replace(0, pos, count, first, last);
+    }
+    template <typename InputIterator>
+    cost_type replace_second(const size_type& pos, const size_type& count, InputIterator first, InputIterator last) {
+        return replace(1, pos, count, first, last);
+    }
+
+    // diffs the sequences from scratch
+    cost_type diff() {
+        ops.clear();
+        detail::script_recorder<value_type, cost_type> recorder(ops);
+        total = edit_distance(S1, S2, parameter::_script=recorder, parameter::_cost=cost, parameter::_equal=equal, parameter::_substitution=allow_sub);
+        excess_bound = 0;
+        ++diffs;
+        return total;
+    }
+
+    // calls the handler for each operation of the script held, as edit_distance(..., _script=out),
+    // after a diff of the whole if excess() has passed slack()
+    template <typename Output>
+    void script(Output& out) {
+        if (excess_bound > slack_cost) diff();
+        const detail::sub_checker<AllowSub, Cost, cost_type, Output> sub(allow_sub);
+        std::size_t j1 = 0;
+        std::size_t j2 = 0;
+        for (typename runs_t::const_iterator r = ops.begin();  r != ops.end();  ++r) {
+            for (std::size_t k = 0;  k < r->length;  ++k) {
+                switch (r->op) {
+                    case detail::script_eql: out.equality(S1[j1], S2[j2]);  ++j1;  ++j2;  break;
+                    case detail::script_sub: sub.substitution(out, S1[j1], S2[j2], sub.substitution(cost, S1[j1], S2[j2]));  ++j1;  ++j2;  break;
+                    case detail::script_ins: out.insertion(S2[j2], cost.insertion(S2[j2]));  ++j2;  break;
+                    case detail::script_del: out.deletion(S1[j1], cost.deletion(S1[j1]));  ++j1;  break;
+                }
+            }
+        }
+    }
+
+private:
+    typedef std::vector<detail::script_run<cost_type> > runs_t;
+    typedef typename std::vector<value_type>::const_iterator itr_t;
+
+    // a point of the script: (offset) operations into run (run)
+    struct point {
+        std::size_t run;
+        std::size_t offset;
+    };
+
+    // the elements of each sequence an operation takes
+    static inline std::size_t takes(const int& op, const int& side) {
+        if (op == detail::script_eql  ||  op == detail::script_sub) return 1;
+        return (op == ((side == 0) ? detail::script_del : detail::script_ins)) ? 1 : 0;
+    }
+
+    // the point at the operation that takes element (pos) of a sequence, or the end of the script
+    point locate(const int& side, const std::size_t& pos) const {
+        point p;
+        std::size_t x = 0;
+        for (p.run = 0;  p.run < ops.size();  ++p.run) {
+            const std::size_t t = ops[p.run].length * takes(ops[p.run].op, side);
+            if (x + t > pos) {
+                p.offset = pos - x;
+                return p;
+            }
+            x += t;
+        }
+        p.offset = 0;
+        return p;
+    }
+
+    // the positions in each sequence of a point
+    void coordinates(const point& p, std::size_t& j1, std::size_t& j2) const {
+        j1 = j2 = 0;
+        for (std::size_t r = 0;  r <= p.run  &&  r < ops.size();  ++r) {
+            const std::size_t n = (r < p.run) ? ops[r].length : p.offset;
+            j1 += n * takes(ops[r].op, 0);
+            j2 += n * takes(ops[r].op, 1);
+        }
+    }
+
+    // Widens the window [b, e) over runs of other operations next to it, until (context) equal
+    // elements lie between it and them, or a sequence ends
+    void widen(point& b, point& e) const {
+        std::size_t need = context;
+        while (true) {
+            if (b.offset == 0) {
+                if (b.run == 0) break;
+                --b.run;
+                b.offset = ops[b.run].length;
+            }
+            if (ops[b.run].op != detail::script_eql) {
+                b.offset = 0;
+                continue;
+            }
+            const std::size_t t = std::min(b.offset, need);
+            b.offset -= t;
+            need -= t;
+            if (need == 0) break;
+        }
+        need = context;
+        while (e.run < ops.size()) {
+            if (e.offset == ops[e.run].length) {
+                ++e.run;
+                e.offset = 0;
+                continue;
+            }
+            if (ops[e.run].op != detail::script_eql) {
+                e.offset = ops[e.run].length;
+                continue;
+            }
+            const std::size_t t = std::min(ops[e.run].length - e.offset, need);
+            e.offset += t;
+            need -= t;
+            if (need == 0) break;
+        }
+    }
+
+    template <typename InputIterator>
+    cost_type replace(const int& side, const size_type& pos, const size_type& count, InputIterator first, InputIterator last) {
+        std::vector<value_type>& S = (side == 0) ? S1 : S2;
+        BOOST_ASSERT(pos + count <= S.size());
+
+        // the window: from the operation taking element (pos), to the one after that taking the
+        // last element replaced, widened
+        point b = locate(side, pos);
+        point e = (count > 0) ? locate(side, pos + count - 1) : b;
+        if (count > 0) ++e.offset;
+        widen(b, e);
+        std::size_t b1, b2, e1, e2;
+        coordinates(b, b1, b2);
+        coordinates(e, e1, e2);
+
+        // the cost of the old script over the window: runs are cut only within equal runs
+        const std::size_t rend = (e.offset > 0) ? e.run + 1 : e.run;
+        cost_type old = 0;
+        for (std::size_t r = b.run;  r < rend;  ++r) old += ops[r].cost;
+
+        // the cost of undoing the edit, which is at most what it can lower the edit distance by:
+        // the removed elements here, and the new ones once they are in place
+        cost_type undo = 0;
+        for (std::size_t k = pos;  k < pos + count;  ++k) undo += (side == 0) ? cost.deletion(S[k]) : cost.insertion(S[k]);
+
+        // replace the elements, and diff the window with them
+        const std::size_t n0 = S.size();
+        // Elements replaced one for one are assigned, and only a difference in length moves the rest,
+        // by swaps, which for elements such as strings don't copy them
+        using std::swap;
+        std::size_t j = pos;
+        for (;  j < pos + count  &&  first != last;  ++j, ++first) S[j] = *first;
+        if (j < pos + count) {
+            const std::size_t d = pos + count - j;
+            for (std::size_t k = pos + count;  k < S.size();  ++k) swap(S[k-d], S[k]);
+            S.resize(S.size() - d);
+        } else if (first != last) {
+            std::vector<value_type> rest(first, last);
+            const std::size_t d = rest.size();
+            S.resize(S.size() + d);
+            for (std::size_t k = S.size() - d;  k-- > j;  ) swap(S[k], S[k+d]);
+            for (std::size_t k = 0;  k < d;  ++k) swap(S[j+k], rest[k]);
+        }
+        for (std::size_t k = pos;  k < pos + count + S.size() - n0;  ++k) undo += (side == 0) ? cost.insertion(S[k]) : cost.deletion(S[k]);
+        if (side == 0) e1 = e1 + S.size() - n0;
+        else e2 = e2 + S.size() - n0;
+
+        // a window of the whole is a diff from scratch
+        if (b1 == 0  &&  b2 == 0  &&  e1 == S1.size()  &&  e2 == S2.size()) return diff();
+        runs_t window;
+        detail::script_recorder<value_type, cost_type> recorder(window);
+        const cost_type c = edit_distance(boost::make_iterator_range(S1.begin() + b1, S1.begin() + e1),
+                                          boost::make_iterator_range(S2.begin() + b2, S2.begin() + e2),
+                                          parameter::_script=recorder, parameter::_cost=cost, parameter::_equal=equal, parameter::_substitution=allow_sub);
+
+        // splice the new runs in place of the old
+        runs_t spliced;
+        spliced.reserve(ops.size() + window.size() + 2);
+        spliced.insert(spliced.end(), ops.begin(), ops.begin() + b.run);
+        if (b.offset > 0) detail::push_script_run(spliced, ops[b.run].op, b.offset, cost_type(0));
+        for (typename runs_t::const_iterator r = window.begin();  r != window.end();  ++r) detail::push_script_run(spliced, r->op, r->length, r->cost);
+        if (e.offset > 0  &&  e.offset < ops[e.run].length) detail::push_script_run(spliced, ops[e.run].op, ops[e.run].length - e.offset, cost_type(0));
+        for (std::size_t r = rend;  r < ops.size();  ++r) detail::push_script_run(spliced, ops[r].op, ops[r].length, ops[r].cost);
+        ops.swap(spliced);
+
+        total = total - old + c;
+        excess_bound = std::max(cost_type(0), excess_bound + undo - (old - c));
+        return total;
+    }
+
+    std::vector<value_type> S1;
+    std::vector<value_type> S2;
+    std::size_t context;
+    Cost cost;
+    AllowSub allow_sub;
+    Equal equal;
+    runs_t ops;
+    cost_type total;
+    cost_type excess_bound;
+    cost_type slack_cost;
+    size_type diffs;
+};
+
+}}} // boost::algorithm::sequence
+
+#endif
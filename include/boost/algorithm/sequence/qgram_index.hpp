@@ -0,0 +1,186 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_QGRAM_INDEX_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_QGRAM_INDEX_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_postings.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+namespace detail {
+
+// the keys of the distinct q-grams of a sequence, in increasing order.  The keys are hashes, and
+// q-grams whose keys collide are taken as one, which only ever lets more records through the filter
+template <typename Range>
+void qgram_keys(Range const& seq, const std::size_t& q, std::vector<std::size_t>& keys) {
+    typedef typename range_iterator<Range const>::type itr_t;
+    keys.clear();
+    itr_t e = boost::begin(seq);
+    for (std::size_t k = 0;  k < q;  ++k, ++e) if (e == boost::end(seq)) return;
+    for (itr_t b = boost::begin(seq);  ;  ++b, ++e) {
+        std::size_t h = 0;
+        for (itr_t j = b;  j != e;  ++j) boost::hash_combine(h, *j);
+        keys.push_back(h);
+        if (e == boost::end(seq)) break;
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+} // detail
+
+// An index of records (sequences) for lookups of those within a unit cost edit distance of a query,
+// through the q-grams (runs of q elements) they share with it.  An edit destroys at most q of the
+// q-grams of a sequence, so a record within (k) of the query shares at least all but (kq) of the
+// distinct q-grams of either:
+//     Approximate String-Matching with q-grams and Maximal Matches
+//     by Esko Ukkonen, Theoretical Computer Science 92, 1992
+// Records that pass this count filter, and the difference in length, are verified by an edit
+// distance under a max cost of (k).  The records holding each q-gram are kept in compressed posting
+// lists (see posting_list).  Elements are compared with operator== and hashed with boost::hash.
+// Lookups may run concurrently, each in the default workspace of its thread; an insertion
+// invalidates the iterators to records, as for a std::vector.
+template <typename Sequence, typename AllowSub = boost::false_type>
+class qgram_index {
+public:
+    typedef Sequence value_type;
+    typedef unit_cost::cost_type cost_type;
+    typedef typename std::vector<Sequence>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef typename std::vector<Sequence>::size_type size_type;
+    // a record found by a lookup, and its distance from the query
+    typedef std::pair<const_iterator, cost_type> match_type;
+
+    explicit qgram_index(const std::size_t& q_ = 3, const AllowSub& allow_sub_ = AllowSub()) : q(q_), allow_sub(allow_sub_) {}
+
+    // records in the order they were inserted
+    const_iterator begin() const { return records.begin(); }
+    const_iterator end() const { return records.end(); }
+    size_type size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+
+    // the number of distinct q-gram keys, and the bytes their posting lists take
+    std::size_t grams() const { return postings.size(); }
+    std::size_t posting_bytes() const {
+        std::size_t b = 0;
+        for (typename postings_t::const_iterator j = postings.begin();  j != postings.end();  ++j) b += j->second.byte_size();
+        return b;
+    }
+
+    void clear() {
+        records.clear();
+        lengths.clear();
+        distinct.clear();
+        postings.clear();
+    }
+
+    const_iterator insert(const Sequence& seq) {
+        const boost::uint32_t r = boost::uint32_t(records.size());
+        std::vector<std::size_t> keys;
+        detail::qgram_keys(as_literal(seq), q, keys);
+        for (std::size_t j = 0;  j < keys.size();  ++j) postings[keys[j]].push_back(r);
+        records.push_back(seq);
+        lengths.push_back(std::size_t(boost::distance(as_literal(seq))));
+        distinct.push_back(boost::uint32_t(keys.size()));
+        return records.end() - 1;
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (;  first != last;  ++first) insert(*first);
+    }
+
+    // Writes every record within distance (k) of a query to an output iterator, as a match_type, in
+    // the order they were inserted.  Returns the output iterator past the last match
+    template <typename Query, typename OutputIterator>
+    OutputIterator find_within(const Query& query, const cost_type& k, OutputIterator out) const {
+        typedef typename range_iterator<Query const>::type itr_t;
+        typedef boost::iterator_range<itr_t> range_t;
+        const range_t qr(as_literal(query));
+        const std::size_t qlen = std::size_t(boost::distance(qr));
+
+        detail::default_workspace workspace;
+        detail::batch_query<range_t, unit_cost, detail::default_equal, AllowSub> verify(qr, unit_cost(), detail::default_equal(), allow_sub);
+        const detail::max_cost_bound<cost_type> max_cost(k);
+
+        std::vector<std::size_t> keys;
+        detail::qgram_keys(qr, q, keys);
+        const std::size_t lost = k*q;
+
+        // with no q-grams the query must share, every record of a near enough length is a candidate
+        if (keys.size() <= lost) {
+            for (std::size_t r = 0;  r < records.size();  ++r) {
+                if (!length_within(lengths[r], qlen, k)) continue;
+                const cost_type d = verify(as_literal(records[r]), max_cost, workspace.get());
+                if (d <= k) {
+                    *out = match_type(records.begin() + r, d);
+                    ++out;
+                }
+            }
+            return out;
+        }
+
+        detail::workspace_lease<detail::posting_counts> c(workspace.get());
+        c->count.resize(records.size(), 0);
+        c->touched.clear();
+        for (std::size_t j = 0;  j < keys.size();  ++j) {
+            const typename postings_t::const_iterator p = postings.find(keys[j]);
+            if (p != postings.end()) p->second.for_each(*c);
+        }
+
+        std::sort(c->touched.begin(), c->touched.end());
+        const std::size_t need = keys.size() - lost;
+        for (std::size_t j = 0;  j < c->touched.size();  ++j) {
+            const boost::uint32_t r = c->touched[j];
+            const std::size_t shared = c->count[r];
+            c->count[r] = 0;
+            if (shared < need  ||  shared + lost < distinct[r]  ||  !length_within(lengths[r], qlen, k)) continue;
+            const cost_type d = verify(as_literal(records[r]), max_cost, workspace.get());
+            if (d <= k) {
+                *out = match_type(records.begin() + r, d);
+                ++out;
+            }
+        }
+        return out;
+    }
+
+private:
+    typedef boost::unordered_map<std::size_t, detail::posting_list> postings_t;
+
+    static inline bool length_within(const std::size_t& a, const std::size_t& b, const std::size_t& k) {
+        return ((a < b) ? (b - a) : (a - b)) <= k;
+    }
+
+    std::size_t q;
+    AllowSub allow_sub;
+    std::vector<Sequence> records;
+    std::vector<std::size_t> lengths;
+    std::vector<boost::uint32_t> distinct;
+    postings_t postings;
+};
+
+}}} // boost::algorithm::sequence
+
+#endif
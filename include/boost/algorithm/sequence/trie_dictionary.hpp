@@ -0,0 +1,157 @@
+/*******
+edit_distance: STL and Boost compatible edit distance functions for C++
+
+Copyright (c) 2013 Erik Erlandson
+
+Author:  Erik Erlandson <erikerlandson@yahoo.com>
+
+Distributed under the Boost Software License, Version 1.0.
+See accompanying file LICENSE or copy at
+http://www.boost.org/LICENSE_1_0.txt
+*******/
+
+
+#if !defined(BOOST_ALGORITHM_SEQUENCE_TRIE_DICTIONARY_HPP)
+#define BOOST_ALGORITHM_SEQUENCE_TRIE_DICTIONARY_HPP
+
+#include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/detail/edit_distance_automaton.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/type_traits/remove_cv.hpp>
+
+namespace boost {
+namespace algorithm {
+namespace sequence {
+
+// A set of sequences held in a trie, for lookups of those within a unit cost edit distance of a
+// query.  A lookup runs the Levenshtein automaton of the query (see levenshtein_automaton) down the
+// trie, so the elements of a prefix shared by many sequences are read once for all of them, and a
+// branch is left as soon as the automaton shows no sequence below it can be within reach.
+// Distances are those of edit_distance() under unit costs, with or without substitution.
+// Lookups may run concurrently; an insertion invalidates the iterators to sequences, as for a
+// std::vector.
+template <typename Sequence, typename AllowSub = boost::false_type, typename Equal = default_equal>
+class trie_dictionary {
+public:
+    typedef Sequence value_type;
+    typedef unit_cost::cost_type cost_type;
+    typedef typename std::vector<Sequence>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef typename std::vector<Sequence>::size_type size_type;
+    // a sequence found by a lookup, and its distance from the query
+    typedef std::pair<const_iterator, cost_type> match_type;
+
+    explicit trie_dictionary(const AllowSub& allow_sub_ = AllowSub(), const Equal& equal_ = Equal())
+        : allow_sub(allow_sub_), equal(equal_), nodes(1, node()) {}
+
+    // sequences in the order they were inserted
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    size_type size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    // the number of nodes of the trie, one for each distinct prefix
+    std::size_t node_count() const { return nodes.size(); }
+
+    void clear() {
+        values.clear();
+        nodes.assign(1, node());
+    }
+
+    // Inserts a sequence, unless an equal one is held already.  Returns the sequence held, and
+    // whether it was inserted
+    std::pair<const_iterator, bool> insert(const Sequence& seq) {
+        typedef typename range_iterator<Sequence const>::type itr_t;
+        std::size_t x = 0;
+        for (itr_t j = boost::begin(as_literal(seq));  j != boost::end(as_literal(seq));  ++j) {
+            std::size_t c = nodes[x].child;
+            while (c != npos  &&  !equal(nodes[c].symbol, *j)) c = nodes[c].sibling;
+            if (c == npos) {
+                nodes.push_back(node(*j));
+                c = nodes.size()-1;
+                nodes[c].sibling = nodes[x].child;
+                nodes[x].child = c;
+            }
+            x = c;
+        }
+        if (nodes[x].value != npos) return std::make_pair(values.begin() + nodes[x].value, false);
+        nodes[x].value = values.size();
+        values.push_back(seq);
+        return std::make_pair(values.end() - 1, true);
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (;  first != last;  ++first) insert(*first);
+    }
+
+    // Writes every sequence within distance (k) of a query to an output iterator, as a match_type,
+    // in no particular order.  Returns the output iterator past the last match
+    template <typename Query, typename OutputIterator>
+    OutputIterator find_within(const Query& query, const cost_type& k, OutputIterator out) const {
+        typedef typename range_iterator<Query const>::type itr_t;
+        typedef boost::iterator_range<itr_t> range_t;
+        const detail::levenshtein_automaton<range_t, Equal, AllowSub> a(range_t(as_literal(query)), k, equal, allow_sub);
+        const std::size_t w = a.width();
+
+        // the state of the automaton at each depth of the path to the node being visited: a node
+        // is visited only after the nodes above it, and before any of their other children
+        std::vector<cost_type> states(w);
+        a.start(&states[0]);
+        if (nodes[0].value != npos  &&  a.distance(&states[0], 0) <= k) {
+            *out = match_type(values.begin() + nodes[0].value, a.distance(&states[0], 0));
+            ++out;
+        }
+        std::vector<std::pair<std::size_t, std::size_t> > stack;
+        for (std::size_t c = nodes[0].child;  c != npos;  c = nodes[c].sibling) stack.push_back(std::make_pair(c, std::size_t(1)));
+        while (!stack.empty()) {
+            const std::size_t x = stack.back().first;
+            const std::size_t j = stack.back().second;
+            stack.pop_back();
+            if (states.size() < (j+1)*w) states.resize((j+1)*w);
+            cost_type* state = &states[j*w];
+            a.step(state - w, j, nodes[x].symbol, state);
+            if (nodes[x].value != npos) {
+                const cost_type d = a.distance(state, j);
+                if (d <= k) {
+                    *out = match_type(values.begin() + nodes[x].value, d);
+                    ++out;
+                }
+            }
+            if (!a.live(state)) continue;
+            for (std::size_t c = nodes[x].child;  c != npos;  c = nodes[c].sibling) stack.push_back(std::make_pair(c, j+1));
+        }
+        return out;
+    }
+
+private:
+    typedef typename boost::remove_cv<typename range_value<Sequence>::type>::type symbol_t;
+    static const std::size_t npos = std::size_t(-1);
+
+    // a node holds the last element of its prefix, the links from its first child to the next, and
+    // the index of the sequence that ends there, if any
+    struct node {
+        symbol_t symbol;
+        std::size_t child;
+        std::size_t sibling;
+        std::size_t value;
+        node() : symbol(), child(npos), sibling(npos), value(npos) {}
+        explicit node(const symbol_t& symbol_) : symbol(symbol_), child(npos), sibling(npos), value(npos) {}
+    };
+
+    AllowSub allow_sub;
+    Equal equal;
+    std::vector<Sequence> values;
+    std::vector<node> nodes;
+};
+
+template <typename Sequence, typename AllowSub, typename Equal>
+const std::size_t trie_dictionary<Sequence, AllowSub, Equal>::npos;
+
+}}} // boost::algorithm::sequence
+
+#endif
@@ -307,6 +307,868 @@ BOOST_AUTO_TEST_CASE(myers_sssp_crosscheck_2) {
 }
 
 
+BOOST_AUTO_TEST_CASE(bitparallel_sssp_crosscheck_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 10000;
+    // lengths straddle the 64-element word size, to exercise both bit-parallel and fallback
+    random_localized_deviations(seqdata, N, 60, 3, 10);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _cost=unit_cost_test());
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j]);
+            // non-byte elements and custom equality use the generic match masks
+            unsigned int d3 = edit_distance(ASVECTOR(seqdata[i]), seqdata[j], _substitution=boost::true_type(), _equal=case_equal());
+            BOOST_CHECK_EQUAL(d3, d2);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(bitparallel_sssp_crosscheck_2) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    // multiple blocks of words, with enough differences that the band has to grow
+    random_localized_deviations(seqdata, N, 400, 5, 40);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _cost=unit_cost_test());
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j]);
+            unsigned int d3 = edit_distance(ASVECTOR(seqdata[i]), seqdata[j], _substitution=boost::true_type(), _equal=case_equal());
+            BOOST_CHECK_EQUAL(d3, d2);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(bitparallel_lcs_sssp_crosscheck) {
+    srand(time(0));
+    char data[] = "abcdefgh";
+    const int N = 100;
+    // unrelated random sequences: Myers hands off to the bit-parallel LCS
+    int n = 0;
+    double t0 = time(0);
+    for (;  n < N;  ++n) {
+        std::string seq1(50 + rand()%300, 'x');
+        std::string seq2(50 + rand()%300, 'x');
+        for (int j = 0;  j < seq1.size();  ++j) seq1[j] = data[rand()%(sizeof(data)-1)];
+        for (int j = 0;  j < seq2.size();  ++j) seq2[j] = data[rand()%(sizeof(data)-1)];
+        unsigned int d1 = edit_distance(seq1, seq2);
+        unsigned int d2 = edit_distance(seq1, seq2, _cost=unit_cost_test(), _substitution=boost::false_type());
+        BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seq1 << "'\nseq2= '"<< seq2);
+        unsigned int d3 = edit_distance(ASVECTOR(seq1), seq2, _equal=case_equal());
+        BOOST_CHECK_EQUAL(d3, d2);
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(diagonal_sssp_crosscheck) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    // similar sequences, well past one word, resolved by furthest-reaching diagonals
+    random_localized_deviations(seqdata, N, 2000, 5, 20);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _cost=unit_cost_test());
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j]);
+            // a max cost below the distance gives the cost of some path exceeding it
+            unsigned int d3 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _max_cost=d2/2);
+            BOOST_CHECK(d3 > d2/2  &&  d3 >= d2);
+            BOOST_CHECK_THROW(edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _max_cost=d2-1, _max_cost_exception=true), max_edit_cost_exception);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+BOOST_AUTO_TEST_CASE(snake_index_crosscheck) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    // long equal runs, answered by a suffix array index built at the first one
+    random_localized_deviations(seqdata, N, 2000, 5, 20);
+    lcp_index<char> index(0);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j]);
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _snake_index=index);
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j]);
+            // a second query on the same pair reuses the index
+            d2 = edit_distance(seqdata[i], seqdata[j], _snake_index=index);
+            BOOST_CHECK_EQUAL(d1, d2);
+            d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _snake_index=index);
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j]);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+
+    // a pair too long for the positions of the index is compared directly, and never read past the
+    // snake asked for
+    const std::string a = "abcdefgh";
+    const std::string b = "abcdexgh";
+    BOOST_CHECK(!lcp_index<char>::indexable(0x7fffffff, 0));
+    BOOST_CHECK(lcp_index<char>::indexable(a.size(), b.size()));
+    index.start();
+    BOOST_CHECK_EQUAL(index.forward(a.begin(), 0x7fffffff, b.begin(), b.size(), 0, 0, 8), 5);
+    BOOST_CHECK_EQUAL(index.reverse(a.begin(), 0x7fffffff, b.begin(), b.size(), 8, 8, 8), 2);
+}
+
+BOOST_AUTO_TEST_CASE(named_past_arity) {
+    // every parameter named, more of them than the default arity of Boost.Parameter, the last ones
+    // past it included
+    const std::string s1 = "a1b2c3d4";
+    const std::string s2 = "axb2y3d";
+    lcp_index<char> index;
+    edit_distance_workspace workspace;
+    edit_distance_filter_stats stats;
+    output_check_script_string out(s1, s2);
+    const unsigned int d = edit_distance(s1, s2, _script=out, _cost=cost_mixed_ops(), _equal=default_equal(), _substitution=true_type(),
+                                         _max_cost=100, _max_cost_exception=false, _snake_index=index, _workspace=workspace);
+    out.finalize(d);
+    BOOST_CHECK(out.correct);
+    BOOST_CHECK_EQUAL(d, 4);
+    output_check_script_string out2(s1, s2);
+    const unsigned int d2 = edit_distance(s1, s2, _equal=default_equal(), _substitution=true_type(), _max_cost=100,
+                                          _max_cost_exception=false, _script=out2, _snake_index=index, _workspace=workspace, _cost=cost_mixed_ops());
+    out2.finalize(d2);
+    BOOST_CHECK(out2.correct);
+    BOOST_CHECK_EQUAL(d2, 4);
+    const unsigned int d3 = edit_distance(s1, s2, _workspace=workspace, _cost=cost_mixed_ops(), _substitution=true_type(), _max_cost=100,
+                                          _max_cost_exception=false, _snake_index=index, _equal=default_equal());
+    BOOST_CHECK_EQUAL(d3, 4);
+    BOOST_CHECK(edit_distance_within(s1, s2, 3, _cost=unit_cost(), _equal=default_equal(), _substitution=true_type(),
+                                     _snake_index=index, _workspace=workspace, _filter_stats=stats));
+    BOOST_CHECK(!edit_distance_within(s1, s2, 2, _cost=unit_cost(), _equal=default_equal(), _substitution=true_type(),
+                                      _snake_index=index, _workspace=workspace, _filter_stats=stats));
+}
+
+BOOST_AUTO_TEST_CASE(materialized_ranges) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    // sequences without random access, buffered for the unit cost engines
+    random_localized_deviations(seqdata, N, 500, 5, 10);
+    int n = 0;
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j]);
+            unsigned int d2 = edit_distance(ASLIST(seqdata[i]), ASLIST(seqdata[j]));
+            BOOST_CHECK_EQUAL(d1, d2);
+            d2 = edit_distance(ASLIST(seqdata[i]) | boost::adaptors::reversed, ASLIST(seqdata[j]) | boost::adaptors::reversed);
+            BOOST_CHECK_EQUAL(d1, d2);
+            d2 = edit_distance(ASLIST(seqdata[i]), ASLIST(seqdata[j]), _cost=unit_cost_test());
+            BOOST_CHECK_EQUAL(d1, d2);
+            d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            d2 = edit_distance(seqdata[i], ASLIST(seqdata[j]), _substitution=boost::true_type());
+            BOOST_CHECK_EQUAL(d1, d2);
+            d2 = edit_distance(ASLIST(seqdata[i]), ASLIST(seqdata[j]), _substitution=boost::true_type(), _cost=unit_cost_test());
+            BOOST_CHECK_EQUAL(d1, d2);
+            if (++n >= N) break;
+        }
+    }
+}
+
+// strings are equal when their distance in the shared workspace is zero
+struct workspace_equal {
+    edit_distance_workspace* workspace;
+    workspace_equal(edit_distance_workspace& workspace_) : workspace(&workspace_) {}
+    bool operator()(const std::string& a, const std::string& b) const { return edit_distance(a, b, _workspace=*workspace) == 0; }
+};
+
+BOOST_AUTO_TEST_CASE(workspace_reuse) {
+    srand(time(0));
+    edit_distance_workspace workspace;
+    // one workspace across pairs that grow and shrink, and each engine
+    for (int r = 0;  r < 3;  ++r) {
+        vector<std::string> seqdata;
+        const int N = 50;
+        random_localized_deviations(seqdata, N, (r == 1) ? 2000 : 100, 5, 10);
+        int n = 0;
+        for (int i = 0;  i < seqdata.size();  ++i) {
+            if (n >= N) break;
+            for (int j = 0;  j < i;  ++j) {
+                unsigned int d1 = edit_distance(seqdata[i], seqdata[j]);
+                unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _workspace=workspace);
+                BOOST_CHECK_EQUAL(d1, d2);
+                d2 = edit_distance(ASLIST(seqdata[i]), ASLIST(seqdata[j]), _workspace=workspace);
+                BOOST_CHECK_EQUAL(d1, d2);
+                d2 = edit_distance(seqdata[i], seqdata[j], _cost=unit_cost_test(), _workspace=workspace);
+                BOOST_CHECK_EQUAL(d1, d2);
+                d1 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+                d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _workspace=workspace);
+                BOOST_CHECK_EQUAL(d1, d2);
+                d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type(), _cost=unit_cost_test(), _workspace=workspace);
+                BOOST_CHECK_EQUAL(d1, d2);
+                if (++n >= N) break;
+            }
+        }
+        if (r == 1) workspace.clear();
+        // the last round keeps nothing between calls
+        if (r == 1) workspace.keep(0);
+    }
+    BOOST_CHECK_EQUAL(workspace.keep(), std::size_t(0));
+    clear_thread_workspace();
+    BOOST_CHECK_EQUAL(edit_distance("kitten", "sitting", _cost=unit_cost_test()), 5);
+
+    // an equality that computes distances in the same workspace as the outer computation
+    vector<std::string> w1, w2;
+    w1.push_back("the");  w1.push_back("quick");  w1.push_back("brown");  w1.push_back("fox");
+    w2.push_back("the");  w2.push_back("quack");  w2.push_back("brown");  w2.push_back("box");
+    BOOST_CHECK_EQUAL(edit_distance(w1, w2, _equal=workspace_equal(workspace), _cost=unit_cost_test(), _workspace=workspace), 4);
+    BOOST_CHECK_EQUAL(edit_distance(w1, w2, _equal=workspace_equal(workspace), _workspace=workspace), 4);
+}
+
+BOOST_AUTO_TEST_CASE(within_threshold) {
+    BOOST_CHECK(edit_distance_within("kitten", "sitting", 5));
+    BOOST_CHECK(!edit_distance_within("kitten", "sitting", 4));
+    BOOST_CHECK(edit_distance_within("kitten", "sitting", 3, _substitution=true_type()));
+    BOOST_CHECK(!edit_distance_within("kitten", "sitting", 2, _substitution=true_type()));
+    BOOST_CHECK(edit_distance_within("abc", "abcdefgh", 5));
+    BOOST_CHECK(!edit_distance_within("abc", "abcdefgh", 4));
+    BOOST_CHECK(edit_distance_within("", "", 0));
+
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    random_localized_deviations(seqdata, N, 200, 3, 5);
+    int n = 0;
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            const unsigned int d = edit_distance(seqdata[i], seqdata[j]);
+            const unsigned int ds = edit_distance(seqdata[i], seqdata[j], _substitution=true_type());
+            for (unsigned int k = (d > 2) ? d-2 : 0;  k <= d+2;  ++k) {
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k), d <= k);
+                BOOST_CHECK_EQUAL(edit_distance_within(ASLIST(seqdata[i]), ASLIST(seqdata[j]), k), d <= k);
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k, _cost=unit_cost_test()), d <= k);
+            }
+            for (unsigned int k = (ds > 2) ? ds-2 : 0;  k <= ds+2;  ++k) {
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k, _substitution=true_type()), ds <= k);
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k, _substitution=true_type(), _cost=unit_cost_test()), ds <= k);
+            }
+            if (++n >= N) break;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(within_filters) {
+    edit_distance_filter_stats stats;
+    // rejected by length, by element counts, by q-gram counts
+    BOOST_CHECK(!edit_distance_within("abc", "abcdefgh", 4, _substitution=true, _filter_stats=stats));
+    BOOST_CHECK(!edit_distance_within("aaaaaaaa", "bbbbbbbb", 4, _substitution=true, _filter_stats=stats));
+    BOOST_CHECK(!edit_distance_within("abababababab", "aabbaabbaabb", 2, _substitution=true, _filter_stats=stats));
+    BOOST_CHECK(edit_distance_within("kitten", "sitting", 3, _substitution=true, _filter_stats=stats));
+    BOOST_CHECK_EQUAL(stats.tested, 4);
+    BOOST_CHECK_EQUAL(stats.length, 1);
+    BOOST_CHECK_EQUAL(stats.histogram, 1);
+    BOOST_CHECK_EQUAL(stats.qgram, 1);
+    BOOST_CHECK_EQUAL(stats.passed(), 1);
+    stats.clear();
+    BOOST_CHECK_EQUAL(stats.tested, 0);
+
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    random_localized_deviations(seqdata, N, 100, 3, 5);
+    int n = 0;
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            const unsigned int d = edit_distance(seqdata[i], seqdata[j]);
+            const unsigned int ds = edit_distance(seqdata[i], seqdata[j], _substitution=true_type());
+            for (unsigned int k = (d > 4) ? d-4 : 0;  k <= d+1;  ++k) {
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k, _substitution=false, _filter_stats=stats), d <= k);
+                BOOST_CHECK_EQUAL(edit_distance_within(ASLIST(seqdata[i]), ASLIST(seqdata[j]), k, _substitution=false), d <= k);
+            }
+            for (unsigned int k = (ds > 4) ? ds-4 : 0;  k <= ds+1;  ++k) {
+                BOOST_CHECK_EQUAL(edit_distance_within(seqdata[i], seqdata[j], k, _substitution=true, _filter_stats=stats), ds <= k);
+            }
+            if (++n >= N) break;
+        }
+    }
+    BOOST_CHECK(stats.passed() <= stats.tested);
+}
+
+BOOST_AUTO_TEST_CASE(batch_crosscheck) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 200, 100, 3, 5);
+    for (int j = 0;  j < 20;  ++j) seqdata.push_back(seqdata[j].substr(0, 10 + rand()%40));
+    seqdata.push_back("");
+
+    vector<unsigned int> r;
+    const std::string queries[] = { seqdata[0], seqdata[1].substr(0, 30), "", std::string(300, 'x') + seqdata[2] };
+    for (int qj = 0;  qj < 4;  ++qj) {
+        const std::string& q = queries[qj];
+        r.assign(seqdata.size(), 0);
+        BOOST_CHECK(edit_distance_batch(q, vector<std::string>(), r.begin()) == r.begin());
+        BOOST_CHECK(edit_distance_batch(q, seqdata, r.begin()) == r.end());
+        for (int j = 0;  j < seqdata.size();  ++j) BOOST_CHECK_EQUAL(r[j], edit_distance(q, seqdata[j]));
+        edit_distance_batch(q, seqdata, r.begin(), _substitution=true_type());
+        for (int j = 0;  j < seqdata.size();  ++j) BOOST_CHECK_EQUAL(r[j], edit_distance(q, seqdata[j], _substitution=true_type()));
+        edit_distance_batch(q, seqdata, r.begin(), _cost=unit_cost_test());
+        for (int j = 0;  j < seqdata.size();  ++j) BOOST_CHECK_EQUAL(r[j], edit_distance(q, seqdata[j]));
+
+        // past the max cost, only that the distance is past it
+        for (unsigned int k = 0;  k < 12;  k += 3) {
+            edit_distance_batch(q, seqdata, r.begin(), _max_cost=k);
+            for (int j = 0;  j < seqdata.size();  ++j) {
+                const unsigned int d = edit_distance(q, seqdata[j]);
+                if (d <= k) BOOST_CHECK_EQUAL(r[j], d);
+                else BOOST_CHECK(r[j] > k);
+            }
+            edit_distance_batch(q, seqdata, r.begin(), _max_cost=k, _substitution=true_type());
+            for (int j = 0;  j < seqdata.size();  ++j) {
+                const unsigned int d = edit_distance(q, seqdata[j], _substitution=true_type());
+                if (d <= k) BOOST_CHECK_EQUAL(r[j], d);
+                else BOOST_CHECK(r[j] > k);
+            }
+        }
+
+        // candidates without random access, or of another element type
+        vector<std::list<char> > lists;
+        vector<vector<int> > ints;
+        for (int j = 0;  j < 20;  ++j) {
+            lists.push_back(std::list<char>(seqdata[j].begin(), seqdata[j].end()));
+            ints.push_back(vector<int>(seqdata[j].begin(), seqdata[j].end()));
+        }
+        const vector<int> iq(q.begin(), q.end());
+        r.clear();
+        edit_distance_batch(q, lists, std::back_inserter(r), _substitution=true_type());
+        edit_distance_batch(iq, ints, std::back_inserter(r), _substitution=true_type());
+        edit_distance_batch(iq, ints, std::back_inserter(r));
+        BOOST_CHECK_EQUAL(r.size(), 60);
+        for (int j = 0;  j < 20;  ++j) {
+            BOOST_CHECK_EQUAL(r[j], edit_distance(q, seqdata[j], _substitution=true_type()));
+            BOOST_CHECK_EQUAL(r[20+j], r[j]);
+            BOOST_CHECK_EQUAL(r[40+j], edit_distance(q, seqdata[j]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(top_k_nearest) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 2000, 60, 3, 8);
+    for (int j = 0;  j < 10;  ++j) seqdata.push_back(seqdata[j]);
+    seqdata.push_back("");
+
+    typedef std::pair<size_t, unsigned int> near_t;
+    const std::string queries[] = { seqdata[0], seqdata[3].substr(0, 30), "" };
+    const size_t ns[] = { 0, 1, 7, 25, seqdata.size(), seqdata.size() + 5 };
+    for (int qj = 0;  qj < 3;  ++qj) {
+        const std::string& q = queries[qj];
+        for (int sub = 0;  sub < 2;  ++sub) {
+            // the nearest by a sort of all the distances, first in the range of those tied
+            vector<std::pair<unsigned int, size_t> > all;
+            for (size_t j = 0;  j < seqdata.size();  ++j) {
+                const unsigned int d = (sub) ? edit_distance(q, seqdata[j], _substitution=true_type()) : edit_distance(q, seqdata[j]);
+                all.push_back(std::make_pair(d, j));
+            }
+            std::sort(all.begin(), all.end());
+            for (int nj = 0;  nj < 6;  ++nj) {
+                const size_t n = ns[nj];
+                vector<near_t> r;
+                if (sub) edit_distance_top_k(q, seqdata, n, std::back_inserter(r), _substitution=true_type());
+                else edit_distance_top_k(q, seqdata, n, std::back_inserter(r));
+                BOOST_CHECK_EQUAL(r.size(), std::min(n, all.size()));
+                for (size_t x = 0;  x < r.size();  ++x) {
+                    BOOST_CHECK_EQUAL(r[x].first, all[x].second);
+                    BOOST_CHECK_EQUAL(r[x].second, all[x].first);
+                }
+
+                // only those within a max cost
+                const unsigned int k = 4;
+                r.clear();
+                if (sub) edit_distance_top_k(q, seqdata, n, std::back_inserter(r), _max_cost=k, _substitution=true_type());
+                else edit_distance_top_k(q, seqdata, n, std::back_inserter(r), _max_cost=k);
+                size_t within = 0;
+                while (within < std::min(n, all.size())  &&  all[within].first <= k) ++within;
+                BOOST_CHECK_EQUAL(r.size(), within);
+                for (size_t x = 0;  x < r.size();  ++x) {
+                    BOOST_CHECK_EQUAL(r[x].first, all[x].second);
+                    BOOST_CHECK_EQUAL(r[x].second, all[x].first);
+                }
+            }
+        }
+
+        // costs other than unit, and the workspace given
+        edit_distance_workspace workspace;
+        vector<std::pair<int, size_t> > all;
+        for (size_t j = 0;  j < seqdata.size();  ++j) all.push_back(std::make_pair(edit_distance(q, seqdata[j], _cost=cost_mixed_ops()), j));
+        std::sort(all.begin(), all.end());
+        vector<std::pair<size_t, int> > r(10);
+        BOOST_CHECK(edit_distance_top_k(q, seqdata, 10, r.begin(), _cost=cost_mixed_ops(), _workspace=workspace) == r.end());
+        for (size_t x = 0;  x < r.size();  ++x) {
+            BOOST_CHECK_EQUAL(r[x].first, all[x].second);
+            BOOST_CHECK_EQUAL(r[x].second, all[x].first);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(stream_appended) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 200, 150, 5, 10);
+
+    // patterns within a block, across blocks, and empty; streams that match them, and that don't
+    const std::string patterns[] = { seqdata[0].substr(0, 40), seqdata[1].substr(0, 70), seqdata[2], "" };
+    const std::string streams[] = { seqdata[3].substr(0, 50) + seqdata[0], seqdata[1].substr(0, 90), seqdata[2] + seqdata[4].substr(0, 30), seqdata[5].substr(0, 20) };
+    for (int pj = 0;  pj < 4;  ++pj) {
+        const std::string& p = patterns[pj];
+        edit_distance_stream<std::string> s1(p);
+        edit_distance_stream<std::string, unit_cost, boost::true_type> s2(p);
+        edit_distance_stream<std::string, unit_cost, bool> s3(p, unit_cost(), true);
+        edit_distance_stream<std::string, cost_mixed_ops, boost::true_type> s4(p);
+        edit_distance_stream<std::string, unit_cost, boost::false_type, case_equal> s5(p);
+        BOOST_CHECK_EQUAL(s1.pattern_size(), p.size());
+        for (int sj = 0;  sj < 4;  ++sj) {
+            const std::string& t = streams[sj];
+            s1.clear();  s2.clear();  s3.clear();  s4.clear();  s5.clear();
+            BOOST_CHECK(s1.empty());
+            BOOST_CHECK_EQUAL(s1.distance(), p.size());
+            for (std::size_t n = 1;  n <= t.size();  ++n) {
+                s1.push_back(t[n-1]);  s2.push_back(t[n-1]);  s3.push_back(t[n-1]);  s4.push_back(t[n-1]);  s5.push_back(t[n-1]);
+                const std::string u = t.substr(0, n);
+                BOOST_CHECK_EQUAL(s1.size(), n);
+                BOOST_CHECK_EQUAL(s1.distance(), edit_distance(p, u));
+                BOOST_CHECK_EQUAL(s2.distance(), edit_distance(p, u, _substitution=true_type()));
+                BOOST_CHECK_EQUAL(s3.distance(), edit_distance(p, u, _substitution=true));
+                BOOST_CHECK_EQUAL(s4.distance(), edit_distance(p, u, _cost=cost_mixed_ops(), _substitution=true_type()));
+                BOOST_CHECK_EQUAL(s5.distance(), edit_distance(p, u, _equal=case_equal()));
+                if (n % 7 != 0  &&  n != t.size()) continue;
+
+                // the nearest prefix of the pattern
+                std::size_t d1 = n, d2 = n;
+                int d4 = edit_distance(std::string(), u, _cost=cost_mixed_ops(), _substitution=true_type());
+                for (std::size_t i = 1;  i <= p.size();  ++i) {
+                    d1 = std::min(d1, std::size_t(edit_distance(p.substr(0, i), u)));
+                    d2 = std::min(d2, std::size_t(edit_distance(p.substr(0, i), u, _substitution=true_type())));
+                    d4 = std::min(d4, int(edit_distance(p.substr(0, i), u, _cost=cost_mixed_ops(), _substitution=true_type())));
+                }
+                BOOST_CHECK_EQUAL(s1.prefix_distance(), d1);
+                BOOST_CHECK_EQUAL(s2.prefix_distance(), d2);
+                BOOST_CHECK_EQUAL(s3.prefix_distance(), d2);
+                BOOST_CHECK_EQUAL(s4.prefix_distance(), d4);
+                BOOST_CHECK_EQUAL(s5.prefix_distance(), d1);
+            }
+        }
+    }
+
+    // elements wider than a byte, appended a range at a time
+    const vector<int> ip(seqdata[6].begin(), seqdata[6].end());
+    const vector<int> it(seqdata[7].begin(), seqdata[7].end());
+    edit_distance_stream<vector<int>, unit_cost, boost::true_type> s(ip);
+    s.append(it.begin(), it.end());
+    BOOST_CHECK_EQUAL(s.distance(), edit_distance(ip, it, _substitution=true_type()));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_all_pairs) {
+    srand(time(0));
+    vector<std::string> seqdata, longdata;
+    // pairs of very different cost: short and long sequences, near and far apart
+    random_localized_deviations(seqdata, 40, 50, 3, 5);
+    random_localized_deviations(longdata, 20, 2000, 2, 20);
+    seqdata.insert(seqdata.end(), longdata.begin(), longdata.end());
+    seqdata.push_back("");
+    const std::size_t n = seqdata.size();
+    const std::size_t pairs = n*(n-1)/2;
+
+    vector<unsigned int> m1(pairs+1, 7777), m2(pairs+1, 7777), m3(pairs, 0);
+    BOOST_CHECK(edit_distance_matrix(seqdata, m1.begin(), _threads=1) == m1.begin()+pairs);
+    BOOST_CHECK(edit_distance_matrix(seqdata, m2.begin(), _threads=4) == m2.begin()+pairs);
+    BOOST_CHECK_EQUAL(m1[pairs], 7777);
+    BOOST_CHECK_EQUAL(m2[pairs], 7777);
+    edit_distance_matrix(seqdata, m3.begin(), _substitution=true_type(), _max_cost=10, _threads=3);
+    for (std::size_t i = 0;  i < n;  ++i) {
+        for (std::size_t j = i+1;  j < n;  ++j) {
+            const std::size_t x = edit_distance_matrix_index(n, i, j);
+            const unsigned int d = edit_distance(seqdata[i], seqdata[j]);
+            BOOST_CHECK_EQUAL(m1[x], d);
+            BOOST_CHECK_EQUAL(m2[x], d);
+            BOOST_CHECK_EQUAL(m3[x], std::min(11u, (unsigned int)edit_distance(seqdata[i], seqdata[j], _substitution=true_type())));
+        }
+    }
+
+    // a corpus of fewer than two sequences has no pairs
+    vector<std::string> one(1, "abc");
+    BOOST_CHECK(edit_distance_matrix(one, m1.begin()) == m1.begin());
+    BOOST_CHECK(edit_distance_matrix(vector<std::string>(), m1.begin()) == m1.begin());
+}
+
+// collects the pairs found by a join, by their positions
+struct join_pairs {
+    std::map<std::pair<std::size_t, std::size_t>, unsigned int>& found;
+    explicit join_pairs(std::map<std::pair<std::size_t, std::size_t>, unsigned int>& found_) : found(found_) {}
+    void operator()(const std::size_t& i, const std::size_t& j, const std::size_t& d) const {
+        BOOST_CHECK(found.insert(std::make_pair(std::make_pair(i, j), (unsigned int)d)).second);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(join_pairs_within) {
+    srand(time(0));
+    vector<std::string> seqdata, shortdata;
+    // clusters of near sequences, and short sequences that can't be cut into segments
+    random_localized_deviations(seqdata, 5000, 20, 3, 2);
+    random_localized_deviations(shortdata, 40, 3, 2, 1);
+    seqdata.insert(seqdata.end(), shortdata.begin(), shortdata.end());
+    seqdata.push_back("");
+    seqdata.push_back(seqdata[5]);
+    std::random_shuffle(seqdata.begin(), seqdata.end());
+    vector<std::string> other(seqdata.begin(), seqdata.begin() + 40);
+    for (int j = 0;  j < other.size();  ++j) if (!other[j].empty()) other[j][rand()%other[j].size()] = 'x';
+    other.push_back("ab");
+
+    typedef std::map<std::pair<std::size_t, std::size_t>, unsigned int> pairs_t;
+    for (unsigned int k = 0;  k <= 4;  ++k) {
+        pairs_t found, subfound, rsfound;
+        const std::size_t n = edit_distance_join(seqdata, k, join_pairs(found));
+        BOOST_CHECK_EQUAL(n, found.size());
+        edit_distance_join(seqdata, k, join_pairs(subfound), _substitution=true_type());
+        const std::size_t rsn = edit_distance_join(seqdata, other, k, join_pairs(rsfound), _substitution=true);
+        BOOST_CHECK_EQUAL(rsn, rsfound.size());
+        std::size_t expected = 0, subexpected = 0, rsexpected = 0;
+        for (std::size_t i = 0;  i < seqdata.size();  ++i) {
+            for (std::size_t j = i+1;  j < seqdata.size();  ++j) {
+                const unsigned int d = edit_distance(seqdata[i], seqdata[j]);
+                if (d <= k) {
+                    ++expected;
+                    BOOST_CHECK_EQUAL(found[std::make_pair(i, j)], d);
+                }
+                const unsigned int ds = edit_distance(seqdata[i], seqdata[j], _substitution=true_type());
+                if (ds <= k) {
+                    ++subexpected;
+                    BOOST_CHECK_EQUAL(subfound[std::make_pair(i, j)], ds);
+                }
+            }
+            for (std::size_t j = 0;  j < other.size();  ++j) {
+                const unsigned int d = edit_distance(seqdata[i], other[j], _substitution=true_type());
+                if (d <= k) {
+                    ++rsexpected;
+                    BOOST_CHECK_EQUAL(rsfound[std::make_pair(i, j)], d);
+                }
+            }
+        }
+        BOOST_CHECK_EQUAL(found.size(), expected);
+        BOOST_CHECK_EQUAL(subfound.size(), subexpected);
+        BOOST_CHECK_EQUAL(rsfound.size(), rsexpected);
+    }
+
+    pairs_t none;
+    BOOST_CHECK_EQUAL(edit_distance_join(vector<std::string>(), 2, join_pairs(none)), 0);
+    BOOST_CHECK_EQUAL(edit_distance_join(seqdata, vector<std::string>(), 2, join_pairs(none)), 0);
+    BOOST_CHECK(none.empty());
+}
+
+BOOST_AUTO_TEST_CASE(cluster_near_duplicates) {
+    srand(time(0));
+    vector<std::string> seqdata, shortdata;
+    random_localized_deviations(seqdata, 5000, 30, 3, 2);
+    random_localized_deviations(shortdata, 40, 2, 1, 1);
+    seqdata.insert(seqdata.end(), shortdata.begin(), shortdata.end());
+    // exact duplicates always share every bucket
+    for (int j = 0;  j < 10;  ++j) seqdata.push_back(seqdata[j]);
+    seqdata.push_back("");
+    std::random_shuffle(seqdata.begin(), seqdata.end());
+    const std::size_t n = seqdata.size();
+
+    // the clusters of all pairs within k, by the least position in each
+    const unsigned int k = 2;
+    vector<std::size_t> exact(n);
+    for (std::size_t i = 0;  i < n;  ++i) exact[i] = i;
+    for (std::size_t i = 0;  i < n;  ++i) {
+        for (std::size_t j = i+1;  j < n;  ++j) {
+            if (edit_distance(seqdata[i], seqdata[j], _substitution=true_type()) > k) continue;
+            std::size_t a = i, b = j;
+            while (exact[a] != a) a = exact[a];
+            while (exact[b] != b) b = exact[b];
+            exact[std::max(a, b)] = std::min(a, b);
+        }
+    }
+    for (std::size_t i = 0;  i < n;  ++i) exact[i] = exact[exact[i]];
+
+    vector<std::size_t> l1(n, n), l4(n, n), lt(n, n);
+    const std::size_t c1 = edit_distance_cluster(seqdata, k, l1.begin(), _substitution=true_type(), _threads=1);
+    edit_distance_cluster(seqdata, k, l4.begin(), _substitution=true_type(), _threads=4, _lsh=edit_distance_lsh(64, 2));
+    edit_distance_cluster(seqdata, k, lt.begin(), _cost=unit_cost_test(), _substitution=true, _threads=3);
+    BOOST_CHECK(lt == l1);
+    std::size_t roots = 0;
+    for (std::size_t i = 0;  i < n;  ++i) {
+        // labels are the first of each cluster, and clusters never join sequences the exact clusters don't
+        BOOST_CHECK(l1[i] <= i  &&  l1[l1[i]] == l1[i]);
+        BOOST_CHECK_EQUAL(exact[l1[i]], exact[i]);
+        BOOST_CHECK_EQUAL(exact[l4[i]], exact[i]);
+        if (l1[i] == i) ++roots;
+        for (std::size_t j = i+1;  j < n;  ++j) if (seqdata[i] == seqdata[j]) BOOST_CHECK_EQUAL(l1[i], l1[j]);
+    }
+    BOOST_CHECK_EQUAL(roots, c1);
+
+    // one large bucket, of copies of two sequences each a substitution apart, shared out by its rows
+    vector<std::string> copies;
+    for (int j = 0;  j < 300;  ++j) {
+        std::string s = (j%3 == 0) ? "0123456789abcdefghij" : "klmnopqrstuvwxyz9876";
+        s[rand()%s.size()] = 'x';
+        copies.push_back(s);
+    }
+    vector<std::size_t> b1(copies.size()), b4(copies.size());
+    BOOST_CHECK_EQUAL(edit_distance_cluster(copies, k, b1.begin(), _substitution=true_type(), _threads=1, _lsh=edit_distance_lsh(32, 1)), 2);
+    BOOST_CHECK_EQUAL(edit_distance_cluster(copies, k, b4.begin(), _substitution=true_type(), _threads=4, _lsh=edit_distance_lsh(32, 1)), 2);
+    BOOST_CHECK(b4 == b1);
+    for (std::size_t j = 0;  j < copies.size();  ++j) BOOST_CHECK_EQUAL(b1[j], (j%3 == 0) ? 0u : 1u);
+
+    // a single sequence, and none
+    vector<std::size_t> one(1, 7);
+    BOOST_CHECK_EQUAL(edit_distance_cluster(vector<std::string>(1, "abc"), k, one.begin()), 1);
+    BOOST_CHECK_EQUAL(one[0], 0);
+    BOOST_CHECK_EQUAL(edit_distance_cluster(vector<std::string>(), k, one.begin()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(bk_tree_lookups) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 2000, 30, 3, 3);
+    for (int j = 0;  j < 50;  ++j) seqdata.push_back(seqdata[j].substr(0, rand()%30));
+
+    bk_tree<std::string> tree;
+    bk_tree<std::string, boost::algorithm::sequence::unit_cost, true_type> subtree;
+    tree.insert(seqdata.begin(), seqdata.end());
+    subtree.insert(seqdata.begin(), seqdata.end());
+    BOOST_CHECK(!tree.insert(seqdata[3]).second);
+    BOOST_CHECK(*tree.insert(seqdata[3]).first == seqdata[3]);
+    // distinct sequences only
+    vector<std::string> distinct(seqdata);
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    BOOST_CHECK_EQUAL(tree.size(), distinct.size());
+
+    check_index_lookups(tree, seqdata, "", 6, false_type());
+    check_index_lookups(subtree, seqdata, "", 6, true_type());
+
+    typedef bk_tree<std::string>::match_type match_type;
+    for (int qj = 0;  qj < 10;  ++qj) {
+        const std::string q = seqdata[rand()%seqdata.size()] + ((qj%2) ? "ab" : "");
+        vector<unsigned int> all;
+        for (int j = 0;  j < distinct.size();  ++j) all.push_back(edit_distance(q, distinct[j]));
+        std::sort(all.begin(), all.end());
+        vector<match_type> nearest;
+        tree.k_nearest(q, 10, std::back_inserter(nearest));
+        BOOST_CHECK_EQUAL(nearest.size(), 10);
+        for (int j = 0;  j < nearest.size();  ++j) {
+            BOOST_CHECK_EQUAL(nearest[j].second, all[j]);
+            BOOST_CHECK_EQUAL(nearest[j].second, edit_distance(q, *nearest[j].first));
+        }
+    }
+
+    bk_tree<std::string> empty;
+    vector<match_type> none;
+    empty.find_within("abc", 3, std::back_inserter(none));
+    empty.k_nearest("abc", 3, std::back_inserter(none));
+    BOOST_CHECK(none.empty());
+}
+
+BOOST_AUTO_TEST_CASE(qgram_index_lookups) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 2000, 30, 3, 3);
+    // short records, with few or no q-grams, and duplicates
+    for (int j = 0;  j < 50;  ++j) seqdata.push_back(seqdata[j].substr(0, rand()%8));
+    for (int j = 0;  j < 20;  ++j) seqdata.push_back(seqdata[j]);
+
+    qgram_index<std::string> index;
+    // q-grams of 2
+    qgram_index<std::string, true_type> subindex(2);
+    index.insert(seqdata.begin(), seqdata.end());
+    subindex.insert(seqdata.begin(), seqdata.end());
+    BOOST_CHECK_EQUAL(index.size(), seqdata.size());
+    BOOST_CHECK(*index.insert("xyzzy") == "xyzzy");
+
+    // a query shorter than a q-gram
+    check_index_lookups(index, seqdata, "xy", 6, false_type());
+    check_index_lookups(subindex, seqdata, "xy", 6, true_type());
+
+    // matches come out in the order of their records
+    typedef qgram_index<std::string>::match_type match_type;
+    vector<match_type> found;
+    index.find_within(seqdata[0], 6, std::back_inserter(found));
+    BOOST_CHECK(!found.empty());
+    for (int j = 1;  j < found.size();  ++j) BOOST_CHECK(found[j-1].first < found[j].first);
+
+    qgram_index<std::string> empty;
+    vector<match_type> none;
+    empty.find_within("abc", 3, std::back_inserter(none));
+    empty.find_within("abcdefghijkl", 1, std::back_inserter(none));
+    BOOST_CHECK(none.empty());
+}
+
+BOOST_AUTO_TEST_CASE(trie_dictionary_lookups) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 2000, 30, 3, 3);
+    // prefixes of other sequences, the empty sequence, and duplicates
+    for (int j = 0;  j < 50;  ++j) seqdata.push_back(seqdata[j].substr(0, rand()%30));
+    seqdata.push_back("");
+    for (int j = 0;  j < 20;  ++j) seqdata.push_back(seqdata[j]);
+
+    trie_dictionary<std::string> dict;
+    trie_dictionary<std::string, true_type> subdict;
+    // substitution chosen at run time
+    trie_dictionary<std::string, bool> rtdict(true);
+    dict.insert(seqdata.begin(), seqdata.end());
+    subdict.insert(seqdata.begin(), seqdata.end());
+    rtdict.insert(seqdata.begin(), seqdata.end());
+    BOOST_CHECK(!dict.insert(seqdata[3]).second);
+    BOOST_CHECK(*dict.insert(seqdata[3]).first == seqdata[3]);
+    vector<std::string> distinct(seqdata);
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    BOOST_CHECK_EQUAL(dict.size(), distinct.size());
+
+    // the empty query
+    check_index_lookups(dict, seqdata, "", 6, false_type());
+    check_index_lookups(subdict, seqdata, "", 6, true_type());
+    check_index_lookups(rtdict, seqdata, "", 6, true_type());
+
+    typedef trie_dictionary<std::string>::match_type match_type;
+    trie_dictionary<std::string> empty;
+    vector<match_type> none;
+    empty.find_within("abc", 3, std::back_inserter(none));
+    BOOST_CHECK(none.empty());
+    empty.insert("");
+    empty.find_within("ab", 1, std::back_inserter(none));
+    BOOST_CHECK(none.empty());
+    empty.find_within("ab", 2, std::back_inserter(none));
+    BOOST_CHECK_EQUAL(none.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(deletion_index_lookups) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 1000, 12, 2, 2);
+    // short records, runs of equal elements, and duplicates
+    for (int j = 0;  j < 50;  ++j) seqdata.push_back(seqdata[j].substr(0, rand()%6));
+    seqdata.push_back("aaaa");
+    seqdata.push_back("aaab");
+    for (int j = 0;  j < 20;  ++j) seqdata.push_back(seqdata[j]);
+
+    deletion_index<std::string> index;
+    // prefixes of 5, to a depth of 3
+    deletion_index<std::string, true_type> subindex(3, 5);
+    index.insert(seqdata.begin(), seqdata.end());
+    subindex.insert(seqdata.begin(), seqdata.end());
+    BOOST_CHECK_EQUAL(index.size(), seqdata.size());
+    BOOST_CHECK_EQUAL(index.depth(), 2);
+    // the whole of every record
+    deletion_index<std::string> fullindex(2, 100);
+    fullindex.insert(seqdata.begin(), seqdata.end());
+
+    // up to and past the depth indexed, which falls back to a scan
+    check_index_lookups(index, seqdata, "aa", 4, false_type());
+    check_index_lookups(fullindex, seqdata, "aa", 4, false_type());
+    check_index_lookups(subindex, seqdata, "aa", 4, true_type());
+
+    // matches come out in the order of their records
+    typedef deletion_index<std::string>::match_type match_type;
+    vector<match_type> found;
+    index.find_within(seqdata[0], 2, std::back_inserter(found));
+    BOOST_CHECK(!found.empty());
+    for (int j = 1;  j < found.size();  ++j) BOOST_CHECK(found[j-1].first < found[j].first);
+
+    deletion_index<std::string> empty;
+    vector<match_type> none;
+    empty.find_within("abc", 2, std::back_inserter(none));
+    empty.find_within("abc", 3, std::back_inserter(none));
+    BOOST_CHECK(none.empty());
+}
+
+BOOST_AUTO_TEST_CASE(snake_element_types) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 200;
+    // long equal runs, compared over contiguous storage of several element types
+    random_localized_deviations(seqdata, N, 1000, 5, 20);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j]);
+            unsigned int d2 = edit_distance(ASLIST(seqdata[i]), ASLIST(seqdata[j]));
+            BOOST_CHECK_EQUAL(d1, d2);
+            vector<int> s1(seqdata[i].begin(), seqdata[i].end());
+            vector<int> s2(seqdata[j].begin(), seqdata[j].end());
+            BOOST_CHECK_EQUAL(edit_distance(s1, s2), d1);
+            vector<short> t1(seqdata[i].begin(), seqdata[i].end());
+            vector<short> t2(seqdata[j].begin(), seqdata[j].end());
+            BOOST_CHECK_EQUAL(edit_distance(t1, t2), d1);
+            BOOST_CHECK_EQUAL(edit_distance(seqdata[i], seqdata[j], _equal=case_equal()), d1);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+BOOST_AUTO_TEST_CASE(affix_trimming) {
+    // prefix and suffix that overlap, or cover a whole sequence
+    BOOST_CHECK_EQUAL(edit_distance("aaaa", "aa"), 2);
+    BOOST_CHECK_EQUAL(edit_distance("aaaa", "aa", _substitution=true_type()), 2);
+    BOOST_CHECK_EQUAL(edit_distance("abab", "ab", _cost=unit_cost_test()), 2);
+    BOOST_CHECK_EQUAL(edit_distance("abcab", "ab", _substitution=true_type()), 3);
+    BOOST_CHECK_EQUAL(edit_distance(ASLIST("abcab"), ASLIST("ab"), _cost=unit_cost_test()), 3);
+
+    srand(time(0));
+    const std::string alpha = "abcd";
+    for (int n = 0;  n < 100;  ++n) {
+        std::string pfx, sfx, c1, c2;
+        for (int j = rand()%500;  j > 0;  --j) pfx += alpha[rand()%alpha.size()];
+        for (int j = rand()%500;  j > 0;  --j) sfx += alpha[rand()%alpha.size()];
+        for (int j = rand()%10;  j > 0;  --j) c1 += alpha[rand()%alpha.size()];
+        for (int j = rand()%10;  j > 0;  --j) c2 += alpha[rand()%alpha.size()];
+        const std::string s1 = pfx + c1 + sfx;
+        const std::string s2 = pfx + c2 + sfx;
+
+        const unsigned int d = edit_distance(s1, s2, _cost=unit_cost_test());
+        BOOST_CHECK_EQUAL(edit_distance(s1, s2), d);
+        BOOST_CHECK_EQUAL(edit_distance(ASLIST(s1), ASLIST(s2)), d);
+        BOOST_CHECK_EQUAL(edit_distance(c1, c2), d);
+
+        const unsigned int ds = edit_distance(s1, s2, _cost=unit_cost_test(), _substitution=true_type());
+        BOOST_CHECK_EQUAL(edit_distance(s1, s2, _substitution=true_type()), ds);
+        BOOST_CHECK_EQUAL(edit_distance(c1, c2, _substitution=true_type()), ds);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(timing_1) {
     srand(time(0));
     vector<std::string> seqdata;
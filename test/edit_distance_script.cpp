@@ -152,6 +152,34 @@ BOOST_AUTO_TEST_CASE(custom_equal) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(positional_script) {
+    const std::string seq1 = "kitten";
+    const std::string seq2 = "sitting";
+    {
+        output_check_script<char, unsigned> ob(ASVECTOR(seq1), ASVECTOR(seq2));
+        unsigned d = edit_distance(seq1, seq2, unit_cost(), default_equal(), ob);
+        ob.finalize(d);
+        BOOST_CHECK_MESSAGE(ob.correct, "incorrect edit script: '" << ob.ss.str() << "'");
+        BOOST_CHECK_EQUAL(d, 5);
+    }
+    {
+        output_check_script<char, unsigned> ob(ASVECTOR(seq1), ASVECTOR(seq2));
+        unsigned d = edit_distance(seq1, seq2, unit_cost(), default_equal(), ob, true_type());
+        ob.finalize(d);
+        BOOST_CHECK_MESSAGE(ob.correct, "incorrect edit script: '" << ob.ss.str() << "'");
+        BOOST_CHECK_EQUAL(d, 3);
+    }
+    {
+        // past the arity of the parameter specification, with a named argument composed onto it
+        edit_distance_workspace workspace;
+        output_check_script<char, unsigned> ob(ASVECTOR(seq1), ASVECTOR(seq2));
+        unsigned d = edit_distance(seq1, seq2, unit_cost(), default_equal(), ob, true_type(), 10u, false, _workspace=workspace);
+        ob.finalize(d);
+        BOOST_CHECK_MESSAGE(ob.correct, "incorrect edit script: '" << ob.ss.str() << "'");
+        BOOST_CHECK_EQUAL(d, 3);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(myers_empty) {
     CHECK_EDIT_ALIGNMENT_ARG("", "", _substitution=boost::false_type(), 0);
 }
@@ -519,5 +547,352 @@ BOOST_AUTO_TEST_CASE(myers_dist_path_crosscheck_1) {
 }
 
 
+BOOST_AUTO_TEST_CASE(myers_diagonal_widths_1) {
+    srand(time(0));
+    // combined lengths either side of what 16 bit diagonals hold, with enough differences
+    // to move the diagonals out of their initial buffer
+    const int len[] = { 4000, 9000 };
+    for (int r = 0;  r < 2;  ++r) {
+        vector<std::string> seqdata;
+        const int N = 10;
+        random_localized_deviations(seqdata, N, len[r], 20, 10);
+        int n = 0;
+        for (int i = 0;  i < seqdata.size();  ++i) {
+            if (n >= N) break;
+            for (int j = 0;  j < i;  ++j) {
+                output_check_script_long_string out(seqdata[i], seqdata[j]);
+                unsigned int d2 = edit_distance(seqdata[i], seqdata[j]);
+                unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _script = out);
+                out.finalize(d2);
+                BOOST_CHECK(out.correct);
+                BOOST_CHECK_EQUAL(d1, d2);
+                if (++n >= N) break;
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(bitparallel_sssp_crosscheck_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 1000;
+    random_localized_deviations(seqdata, N, 100, 2, 25);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            output_check_script_long_string out1(seqdata[i], seqdata[j]);
+            output_check_script_long_string out2(seqdata[i], seqdata[j]);
+            // bit-parallel algorithm
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _script=out1, _substitution=boost::true_type());
+            out1.finalize(d1);
+            // SSSP algorithm
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _script=out2, _substitution=boost::true_type(), _cost = unit_cost_test());
+            out2.finalize(d2);
+            // verify that the edit script is a correct one: it transforms seq1 into seq2
+            BOOST_CHECK_MESSAGE(out1.correct, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            BOOST_CHECK_MESSAGE(out2.correct, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            // cross-check 
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE(bitparallel_dist_path_crosscheck_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 10;
+    // long enough that the path is split at middle columns, before any traceback
+    random_localized_deviations(seqdata, N, 100000, 5, 20, 100);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            output_check_script_long_string out(seqdata[i], seqdata[j]);
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type());
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _script = out, _substitution=boost::true_type());
+            out.finalize(d2);
+            // verify that the edit script is a correct one: it transforms seq1 into seq2
+            BOOST_CHECK(out.correct);
+            // cross-check 
+            BOOST_CHECK_EQUAL(d1, d2);
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n");
+}
+
+
+BOOST_AUTO_TEST_CASE(diagonal_sssp_crosscheck_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 100;
+    // similar sequences: the script is divided at midpoints found by furthest-reaching diagonals
+    random_localized_deviations(seqdata, N, 2000, 5, 20);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            output_check_script_long_string out1(seqdata[i], seqdata[j]);
+            output_check_script_long_string out2(seqdata[i], seqdata[j]);
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _script=out1, _substitution=boost::true_type());
+            out1.finalize(d1);
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _script=out2, _substitution=boost::true_type(), _cost = unit_cost_test());
+            out2.finalize(d2);
+            BOOST_CHECK_MESSAGE(out1.correct, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            BOOST_CHECK_MESSAGE(d1==d2, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE(snake_index_crosscheck_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 100;
+    // scripts over long equal runs, answered by a suffix array index built at the first one
+    random_localized_deviations(seqdata, N, 2000, 5, 20);
+    lcp_index<char> index(0);
+    int n = 0;
+    double t0 = time(0);
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            output_check_script_long_string out1(seqdata[i], seqdata[j]);
+            output_check_script_long_string out2(seqdata[i], seqdata[j]);
+            unsigned int d1 = edit_distance(seqdata[i], seqdata[j], _script=out1, _snake_index=index);
+            out1.finalize(d1);
+            unsigned int d2 = edit_distance(seqdata[i], seqdata[j], _script=out2, _substitution=boost::true_type(), _snake_index=index);
+            out2.finalize(d2);
+            BOOST_CHECK_MESSAGE(out1.correct, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            BOOST_CHECK_MESSAGE(out2.correct, "\n\nseq1= '" << seqdata[i] << "'\nseq2= '"<< seqdata[j] <<"'\n\n");
+            BOOST_CHECK_EQUAL(d1, edit_distance(seqdata[i], seqdata[j]));
+            BOOST_CHECK_EQUAL(d2, edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type()));
+            if (++n >= N) break;
+        }
+    }
+    double tt = time(0) - t0;
+    BOOST_TEST_MESSAGE("time= " << tt << " sec   n= " << n << "   mean-time= " << tt/double(n) << "\n" );
+}
+
+// records whether every element reported by the script is the original element, in order
+struct output_check_address {
+    output_check_address(const std::list<char>& seq1, const std::list<char>& seq2) : j1(seq1.begin()), j2(seq2.begin()), correct(true) {}
+    void insertion(const char& v2, long) { if (&v2 != &*j2++) correct = false; }
+    void deletion(const char& v1, long) { if (&v1 != &*j1++) correct = false; }
+    void substitution(const char& v1, const char& v2, long) { if (&v1 != &*j1++  ||  &v2 != &*j2++) correct = false; }
+    void equality(const char& v1, const char& v2) { if (&v1 != &*j1++  ||  &v2 != &*j2++) correct = false; }
+    std::list<char>::const_iterator j1;
+    std::list<char>::const_iterator j2;
+    bool correct;
+};
+
+BOOST_AUTO_TEST_CASE(materialized_ranges_1) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    const int N = 100;
+    // sequences without random access are buffered for the unit cost engines
+    random_localized_deviations(seqdata, N, 500, 5, 10);
+    int n = 0;
+    for (int i = 0;  i < seqdata.size();  ++i) {
+        if (n >= N) break;
+        for (int j = 0;  j < i;  ++j) {
+            const std::list<char> s1(seqdata[i].begin(), seqdata[i].end());
+            const std::list<char> s2(seqdata[j].begin(), seqdata[j].end());
+            output_check_script_long_string out1(seqdata[i], seqdata[j]);
+            unsigned int d1 = edit_distance(s1, s2, _script=out1);
+            out1.finalize(d1);
+            BOOST_CHECK(out1.correct);
+            BOOST_CHECK_EQUAL(d1, edit_distance(seqdata[i], seqdata[j]));
+            output_check_script_long_string out2(seqdata[i], seqdata[j]);
+            unsigned int d2 = edit_distance(s1, seqdata[j], _script=out2, _substitution=boost::true_type());
+            out2.finalize(d2);
+            BOOST_CHECK(out2.correct);
+            BOOST_CHECK_EQUAL(d2, edit_distance(seqdata[i], seqdata[j], _substitution=boost::true_type()));
+            // the script is given the elements of the original sequences
+            output_check_address out3(s1, s2);
+            edit_distance(s1, s2, _script=out3);
+            BOOST_CHECK(out3.correct);
+            output_check_address out4(s1, s2);
+            edit_distance(s1, s2, _script=out4, _substitution=boost::true_type());
+            BOOST_CHECK(out4.correct);
+            if (++n >= N) break;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_script_edits) {
+    srand(time(0));
+    vector<std::string> seqdata;
+    random_localized_deviations(seqdata, 50, 300, 5, 10);
+    const char data[] = "abcdefghij";
+
+    for (int sub = 0;  sub < 2;  ++sub) {
+        for (int j = 0;  j+1 < seqdata.size();  ++j) {
+            incremental_edit_script<std::string, unit_cost, bool> inc(seqdata[j], seqdata[j+1], 16, unit_cost(), sub != 0);
+            // a context wider than the sequences re-diffs the whole of them every time
+            incremental_edit_script<std::string, unit_cost, bool> whole(seqdata[j], seqdata[j+1], 100000, unit_cost(), sub != 0);
+            // as does a slack of 0, for the scripts given
+            incremental_edit_script<std::string, unit_cost, bool> exact(seqdata[j], seqdata[j+1], 16, unit_cost(), sub != 0);
+            exact.slack(0);
+            // and with a slack past any edit distance here, only the windows are re-diffed
+            incremental_edit_script<std::string, unit_cost, bool> loose(seqdata[j], seqdata[j+1], 4, unit_cost(), sub != 0);
+            loose.slack(100000);
+            BOOST_CHECK_EQUAL(inc.script_cost(), edit_distance(seqdata[j], seqdata[j+1], _substitution=(sub != 0)));
+            BOOST_CHECK_EQUAL(inc.excess(), 0);
+            for (int e = 0;  e < 20;  ++e) {
+                const int side = rand()%2;
+                const size_t n = (side) ? inc.second().size() : inc.first().size();
+                const size_t pos = rand()%(n+1);
+                const size_t count = std::min(n-pos, size_t(rand()%5));
+                std::string r;
+                for (int k = rand()%5;  k > 0;  --k) r += data[rand()%10];
+                if (side) {
+                    inc.replace_second(pos, count, r.begin(), r.end());
+                    whole.replace_second(pos, count, r.begin(), r.end());
+                    exact.replace_second(pos, count, r.begin(), r.end());
+                    loose.replace_second(pos, count, r.begin(), r.end());
+                } else {
+                    inc.replace_first(pos, count, r.begin(), r.end());
+                    whole.replace_first(pos, count, r.begin(), r.end());
+                    exact.replace_first(pos, count, r.begin(), r.end());
+                    loose.replace_first(pos, count, r.begin(), r.end());
+                }
+                BOOST_CHECK(inc.first() == whole.first());
+                BOOST_CHECK(inc.second() == whole.second());
+
+                const std::string s1(inc.first().begin(), inc.first().end());
+                const std::string s2(inc.second().begin(), inc.second().end());
+                const unsigned int d = edit_distance(s1, s2, _substitution=(sub != 0));
+                output_check_script_long_string out(s1, s2);
+                inc.script(out);
+                out.finalize(inc.script_cost());
+                BOOST_CHECK(out.correct);
+                BOOST_CHECK(inc.script_cost() >= d);
+                BOOST_CHECK(inc.script_cost() <= d + inc.excess());
+                BOOST_CHECK(inc.excess() <= inc.slack());
+                BOOST_CHECK_EQUAL(whole.script_cost(), d);
+                BOOST_CHECK_EQUAL(whole.excess(), 0);
+                output_check_script_long_string eout(s1, s2);
+                exact.script(eout);
+                eout.finalize(exact.script_cost());
+                BOOST_CHECK(eout.correct);
+                BOOST_CHECK_EQUAL(exact.script_cost(), d);
+                output_check_script_long_string lout(s1, s2);
+                loose.script(lout);
+                lout.finalize(loose.script_cost());
+                BOOST_CHECK(lout.correct);
+                BOOST_CHECK(loose.script_cost() >= d);
+                BOOST_CHECK(loose.script_cost() <= d + loose.excess());
+            }
+            BOOST_CHECK_EQUAL(inc.diff(), edit_distance(inc.first(), inc.second(), _substitution=(sub != 0)));
+            BOOST_CHECK_EQUAL(inc.excess(), 0);
+        }
+    }
+
+    // other costs, and a script of the new sequences with the old elements left behind
+    incremental_edit_script<std::string, cost_mixed_ops, boost::true_type> inc(seqdata[0], seqdata[1]);
+    BOOST_CHECK_EQUAL(inc.script_cost(), edit_distance(seqdata[0], seqdata[1], _cost=cost_mixed_ops(), _substitution=true_type()));
+    const std::string r("xyz");
+    inc.replace_second(10, 3, r.begin(), r.end());
+    inc.replace_first(inc.first().size(), 0, r.begin(), r.end());
+    inc.replace_first(0, 2, r.begin(), r.begin());
+    const std::string s1(inc.first().begin(), inc.first().end());
+    const std::string s2(inc.second().begin(), inc.second().end());
+    BOOST_CHECK_EQUAL(s2, seqdata[1].substr(0, 10) + r + seqdata[1].substr(13));
+    BOOST_CHECK_EQUAL(s1, seqdata[0].substr(2) + r);
+    output_check_script_long_string out(s1, s2);
+    inc.script(out);
+    out.finalize(inc.script_cost());
+    BOOST_CHECK(out.correct);
+    BOOST_CHECK(inc.script_cost() >= edit_distance(s1, s2, _cost=cost_mixed_ops(), _substitution=true_type()));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_script_keystrokes) {
+    srand(time(0));
+    // a long document, a few hundred differences from its saved copy, typed into an element at a time
+    const char data[] = "abcdefghij";
+    std::string saved;
+    for (int j = 0;  j < 50000;  ++j) saved += data[rand()%10];
+    std::string document(saved);
+    for (int j = 0;  j < 400;  ++j) document[j*125 + rand()%100] = 'z';
+
+    incremental_edit_script<std::string> inc(saved, document);
+    BOOST_CHECK_EQUAL(inc.full_diffs(), 1);
+    for (int e = 0;  e < 100;  ++e) {
+        const std::string c(1, data[rand()%10]);
+        inc.replace_second(rand()%(inc.second().size()+1), 0, c.begin(), c.end());
+    }
+    // the excess past slack() is caught up with by script(), never by an edit
+    BOOST_CHECK_EQUAL(inc.full_diffs(), 1);
+
+    const std::string s2(inc.second().begin(), inc.second().end());
+    const unsigned int d = edit_distance(saved, s2);
+    output_check_script_long_string out(saved, s2);
+    inc.script(out);
+    out.finalize(inc.script_cost());
+    BOOST_CHECK(out.correct);
+    BOOST_CHECK(inc.full_diffs() <= 2);
+    BOOST_CHECK(inc.script_cost() >= d);
+    BOOST_CHECK(inc.script_cost() <= d + inc.slack());
+}
+
+BOOST_AUTO_TEST_CASE(linear_space_script) {
+    srand(time(0));
+    const char data[] = "abAB12";
+
+    // short sequences divided down to tables of a few entries, under each kind of substitution and equality
+    for (int n = 0;  n < 300;  ++n) {
+        std::string s1, s2;
+        const int len1 = rand()%16;
+        const int len2 = rand()%16;
+        for (int j = 0;  j < len1;  ++j) s1 += data[rand()%6];
+        for (int j = 0;  j < len2;  ++j) s2 += data[rand()%6];
+        const std::size_t cells = 1 + rand()%12;
+        check_linear_script(s1, s2, true_type(), default_equal(), cells);
+        check_linear_script(s1, s2, false_type(), default_equal(), cells);
+        check_linear_script(s1, s2, true, default_equal(), cells);
+        check_linear_script(s1, s2, false, default_equal(), cells);
+        check_linear_script(s1, s2, true_type(), case_equal(), cells);
+        check_linear_script(s1, s2, false_type(), case_equal(), cells);
+        check_linear_script(s1, s2, true, case_equal(), cells);
+        check_linear_script(s1, s2, false, case_equal(), cells);
+    }
+
+    // through edit_distance(), with a workspace that takes every search for general costs to linear space
+    edit_distance_workspace workspace;
+    workspace.script_nodes(0);
+    for (int n = 0;  n < 4;  ++n) {
+        std::string s1, s2;
+        for (int j = 0;  j < 400;  ++j) {
+            s1 += data[rand()%6];
+            s2 += data[rand()%6];
+        }
+
+        output_check_script_long_string out(s1, s2);
+        const unsigned int d = edit_distance(s1, s2, _script=out, _cost=cost_mixed_ops(), _substitution=true_type(), _workspace=workspace);
+        out.finalize(d);
+        BOOST_CHECK(out.correct);
+        BOOST_CHECK_EQUAL(d, edit_distance(s1, s2, _cost=cost_mixed_ops(), _substitution=true_type()));
+
+        output_check_script<char, unsigned, case_equal> outc(ASVECTOR(s1), ASVECTOR(s2));
+        const unsigned int dc = edit_distance(s1, s2, _script=outc, _cost=cost_mixed_ops(), _equal=case_equal(), _substitution=false, _workspace=workspace);
+        outc.finalize(dc);
+        BOOST_CHECK(outc.correct);
+        BOOST_CHECK_EQUAL(dc, edit_distance(s1, s2, _cost=cost_mixed_ops(), _equal=case_equal(), _substitution=false));
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
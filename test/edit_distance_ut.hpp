@@ -19,6 +19,7 @@ http://www.boost.org/LICENSE_1_0.txt
 
 #include <vector>
 #include <list>
+#include <map>
 #include <string>
 #include <iterator>
 #include <algorithm>
@@ -43,11 +44,43 @@ using std::string;
 using boost::true_type;
 using boost::false_type;
 
+// Boost.Parameter ahead of the library, at its own default arity
+#include <boost/parameter.hpp>
+
 #include <boost/algorithm/sequence/edit_distance.hpp>
+#include <boost/algorithm/sequence/edit_distance_matrix.hpp>
+#include <boost/algorithm/sequence/edit_distance_join.hpp>
+#include <boost/algorithm/sequence/edit_distance_cluster.hpp>
+#include <boost/algorithm/sequence/edit_distance_stream.hpp>
+#include <boost/algorithm/sequence/incremental_edit_script.hpp>
+#include <boost/algorithm/sequence/bk_tree.hpp>
+#include <boost/algorithm/sequence/qgram_index.hpp>
+#include <boost/algorithm/sequence/trie_dictionary.hpp>
+#include <boost/algorithm/sequence/deletion_index.hpp>
 
 using boost::algorithm::sequence::edit_distance;
 using namespace boost::algorithm::sequence::parameter;
 using boost::algorithm::sequence::max_edit_cost_exception;
+using boost::algorithm::sequence::lcp_index;
+using boost::algorithm::sequence::edit_distance_workspace;
+using boost::algorithm::sequence::clear_thread_workspace;
+using boost::algorithm::sequence::edit_distance_within;
+using boost::algorithm::sequence::edit_distance_filter_stats;
+using boost::algorithm::sequence::edit_distance_batch;
+using boost::algorithm::sequence::edit_distance_top_k;
+using boost::algorithm::sequence::edit_distance_stream;
+using boost::algorithm::sequence::unit_cost;
+using boost::algorithm::sequence::default_equal;
+using boost::algorithm::sequence::incremental_edit_script;
+using boost::algorithm::sequence::edit_distance_matrix;
+using boost::algorithm::sequence::edit_distance_matrix_index;
+using boost::algorithm::sequence::edit_distance_join;
+using boost::algorithm::sequence::edit_distance_cluster;
+using boost::algorithm::sequence::edit_distance_lsh;
+using boost::algorithm::sequence::bk_tree;
+using boost::algorithm::sequence::qgram_index;
+using boost::algorithm::sequence::trie_dictionary;
+using boost::algorithm::sequence::deletion_index;
 
 template <typename Range>
 std::list<typename boost::range_value<Range>::type>
@@ -410,6 +443,53 @@ struct output_check_script_string {
     BOOST_CHECK_MESSAGE(d == dist, "incorrect edit distance " << d << "(expected " << dist << ")  seq1='" << ASSTRING(seq1) << "' seq2='" << ASSTRING(seq2) << "'  script='" << ob.ss.str() <<"'"); \
 }
 
+// The script of detail::linear_script, dividing the edit graph down to tables of at most (cells)
+// entries, against the cost of edit_distance() under the same cost_mixed_ops, substitution and equality
+template <typename AllowSub, typename Equal>
+void check_linear_script(const std::string& seq1, const std::string& seq2, const AllowSub& allow_sub, const Equal& equal, const std::size_t cells) {
+    typedef std::string::const_iterator itr_t;
+    typedef output_check_script<char, int, Equal> output_t;
+    output_t ob(ASVECTOR(seq1), ASVECTOR(seq2));
+    const boost::algorithm::sequence::detail::sub_checker<AllowSub, cost_mixed_ops, int, output_t> sub(allow_sub);
+    const int d = boost::algorithm::sequence::detail::linear_script<itr_t, itr_t, output_t, cost_mixed_ops, Equal, AllowSub, int>(
+        seq1.begin(), seq1.end(), seq2.begin(), seq2.end(), ob, cost_mixed_ops(), equal, sub, cells)();
+    ob.finalize(d);
+    BOOST_CHECK_MESSAGE(ob.correct, "incorrect edit script: '" << ob.ss.str() << "'  seq1='" << seq1 << "'  seq2='" << seq2 << "'  cells=" << cells);
+    const int dist = edit_distance(seq1, seq2, _cost=cost_mixed_ops(), _equal=equal, _substitution=allow_sub);
+    BOOST_CHECK_MESSAGE(d == dist, "incorrect edit distance " << d << "(expected " << dist << ")  seq1='" << seq1 << "' seq2='" << seq2 << "'  cells=" << cells);
+}
+
+// A lookup of an index, against a scan of all the records it holds: find_within() must find each
+// position within (k) of the query once, and no other, with its edit distance
+template <typename Index, typename AllowSub>
+void check_index_lookup(const Index& index, const std::string& q, const unsigned int k, const AllowSub& allow_sub) {
+    vector<typename Index::match_type> found;
+    index.find_within(q, k, std::back_inserter(found));
+    vector<std::size_t> positions;
+    for (std::size_t j = 0;  j < found.size();  ++j) {
+        positions.push_back(found[j].first - index.begin());
+        BOOST_CHECK_EQUAL(found[j].second, edit_distance(q, *found[j].first, _substitution=allow_sub));
+    }
+    std::sort(positions.begin(), positions.end());
+    vector<std::size_t> expected;
+    for (typename Index::const_iterator j = index.begin();  j != index.end();  ++j) {
+        if (edit_distance(q, *j, _substitution=allow_sub) <= k) expected.push_back(j - index.begin());
+    }
+    BOOST_CHECK_MESSAGE(positions == expected, "lookup of '" << q << "' within " << k << " found " << positions.size() << " positions, expected " << expected.size());
+}
+
+// Lookups in an index of (seqdata), within 0 to (kmax), of the query (q0), then of sequences drawn
+// from (seqdata): as they are, with "ab" appended, and with an element changed to 'z'
+template <typename Index, typename AllowSub>
+void check_index_lookups(const Index& index, const vector<std::string>& seqdata, const std::string& q0, const unsigned int kmax, const AllowSub& allow_sub) {
+    for (int qj = 0;  qj < 20;  ++qj) {
+        std::string q = (qj == 0) ? q0 : seqdata[rand()%seqdata.size()];
+        if (qj%3 == 1) q += "ab";
+        if (qj%3 == 2  &&  !q.empty()) q[rand()%q.size()] = 'z';
+        for (unsigned int k = 0;  k <= kmax;  ++k) check_index_lookup(index, q, k, allow_sub);
+    }
+}
+
 template <typename S>
 void random_localized_deviations(vector<S>& seqdata, const int N, const int LEN, const int D, const int K, const int maxsfx = 100000) {
     char data[] = "abcdefghij0123456789";